@@ -0,0 +1,108 @@
+// Achieved throughput at a given baud rate.
+//
+//   example_throughput /dev/ttyUSB0 12000000 [seconds]   TX looped back to RX (jumper)
+//   example_throughput                                   pseudo-terminal, kernel-only upper bound
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <ComLibPP/PosixSerialDriver.hpp>
+
+using namespace std::chrono_literals;
+
+int main(int argc, char** argv)
+{
+    std::string device;
+    int master = -1;
+    const uint32_t baud = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 12000000u;
+    const auto seconds = std::chrono::seconds{argc > 3 ? std::stoi(argv[3]) : 3};
+
+    if (argc > 1)
+    {
+        device = argv[1];
+    }
+    else
+    {
+        master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        char name[128];
+        if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0 || ::ptsname_r(master, name, sizeof name) != 0)
+        {
+            std::cerr << "no pseudo-terminal\n";
+            return 1;
+        }
+        device = name;
+    }
+
+    ucpgr::PosixSerial port{device, baud};
+    std::cout << device << ": requested " << baud << " baud, driver accepted " << port.actualBaud()
+              << (port.lowLatency() ? " (low latency)" : "") << '\n';
+
+    std::atomic<bool> done {false};
+    std::atomic<uint64_t> received {0};
+
+    // receive side: the port itself on a loopback jumper, else the pty master
+    std::thread reader([&] {
+        std::vector<uint8_t> buf(64 * 1024);
+        while (!done)
+        {
+            std::size_t n = 0;
+            if (master >= 0)
+            {
+                pollfd pfd{master, POLLIN, 0};
+                const auto r = ::poll(&pfd, 1, 100) > 0 ? ::read(master, buf.data(), buf.size()) : 0;
+                n = r > 0 ? static_cast<std::size_t>(r) : 0;
+            }
+            else
+            {
+                n = port.readSome(buf.data(), buf.size(), 100ms);
+            }
+            received += n;
+        }
+    });
+
+    // keep ~10 ms of line time per write, like SerialStreamBuf does
+    const std::size_t chunk = std::max<std::size_t>(4096, baud / 10 / 100);
+    const std::vector<uint8_t> pattern(chunk, 0x55);
+    uint64_t sent = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < seconds)
+    {
+        sent += port.writeSome(pattern.data(), pattern.size(), 100ms);
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::this_thread::sleep_for(200ms);
+    done = true;
+    port.cancelIo();
+    reader.join();
+    if (master >= 0)
+    {
+        ::close(master);
+    }
+
+    const double lineRate = port.actualBaud() / 10.0;  // 8N1
+    const double achieved = static_cast<double>(received) / elapsed;
+    std::cout << "sent " << sent << " B, received " << received << " B in " << elapsed << " s\n"
+              << "achieved " << achieved / 1e6 << " MB/s, line rate " << lineRate / 1e6 << " MB/s ("
+              << 100.0 * achieved / lineRate << "%)\n";
+}
+
+#else
+
+int main()
+{
+    std::cerr << "throughput benchmark needs the Linux termios2 driver\n";
+    return 1;
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef COMLIBPP_BROADCASTREADER_HPP
+#define COMLIBPP_BROADCASTREADER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "ISerialDriver.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Fan-out reader: one thread pumps the driver into ref-counted slabs,
+    // any number of subscribers walk the published slabs with their own cursor.
+    // Bytes are copied once (driver -> slab); the pump never waits on a subscriber.
+    class COMLIBPP_API BroadcastReader
+    {
+        struct Slab;
+
+    public:
+        enum class SlowConsumerPolicy : uint8_t { lag, drop };
+
+        struct Options
+        {
+            std::size_t slabSize {4096};
+            std::size_t ringSlots {64};  // chunks a subscriber may fall behind before it is lagged/dropped
+            SlowConsumerPolicy policy {SlowConsumerPolicy::lag};
+        };
+
+        // one published read; holds a reference on its slab until destroyed
+        class COMLIBPP_API Chunk
+        {
+        public:
+            Chunk() = default;
+            ~Chunk();
+            Chunk(Chunk &&other) noexcept;
+            Chunk& operator=(Chunk &&other) noexcept;
+            Chunk(const Chunk&) = delete;
+            Chunk& operator=(const Chunk&) = delete;
+
+            [[nodiscard]] std::span<const uint8_t> data() const;
+            [[nodiscard]] uint64_t sequence() const { return m_Sequence; }
+            [[nodiscard]] ISerialDriver::RxTimestamp timestamp() const;
+
+        private:
+            friend class BroadcastReader;
+            friend class Subscription;
+            Chunk(Slab *slab, uint64_t sequence) : m_Slab(slab), m_Sequence(sequence) {}
+
+            Slab     *m_Slab {nullptr};
+            uint64_t  m_Sequence {0};
+        };
+
+        // single-consumer cursor; poll() never blocks and never takes a lock
+        class COMLIBPP_API Subscription
+        {
+        public:
+            std::optional<Chunk> poll();
+
+            [[nodiscard]] bool isDropped() const { return m_Dropped; }
+            [[nodiscard]] uint64_t lostChunks() const { return m_Lost; }
+            [[nodiscard]] std::size_t pending() const;
+
+        private:
+            friend class BroadcastReader;
+            Subscription(const BroadcastReader &reader, uint64_t cursor) : m_Reader(&reader), m_Cursor(cursor) {}
+
+            const BroadcastReader *m_Reader;
+            uint64_t               m_Cursor;
+            uint64_t               m_Lost {0};
+            bool                   m_Dropped {false};
+        };
+
+        explicit BroadcastReader(ISerialDriver &driver);
+        BroadcastReader(ISerialDriver &driver, const Options &options);
+        ~BroadcastReader();
+        BroadcastReader(const BroadcastReader&) = delete;
+        BroadcastReader& operator=(const BroadcastReader&) = delete;
+
+        // new subscribers see data published after this call
+        [[nodiscard]] Subscription subscribe() const;
+
+        // one driver read into a fresh slab; returns bytes published (0 == timeout).
+        // Must only be called from a single thread.
+        std::size_t pump(std::chrono::milliseconds timeout);
+
+        [[nodiscard]] uint64_t published() const { return m_Head.load(std::memory_order_acquire); }
+        // safe from any thread; the pool itself is only touched by the pump
+        [[nodiscard]] std::size_t slabCount() const { return m_SlabCount.load(std::memory_order_relaxed); }
+
+    private:
+        Slab* acquireSlab_();
+        static bool retain_(Slab *slab);
+        static void release_(Slab *slab);
+
+    private:
+        ISerialDriver                       &m_Driver;
+        Options                              m_Options;
+        std::vector<std::unique_ptr<Slab>>   m_Pool;      // touched by the pump thread only
+        std::atomic<std::size_t>             m_SlabCount {0};
+        std::unique_ptr<std::atomic<Slab*>[]> m_Ring;
+        std::size_t                          m_NextScan {0};
+        std::atomic<uint64_t>                m_Head {0};  // sequence of the next chunk to publish
+    };
+}
+
+#endif //COMLIBPP_BROADCASTREADER_HPP
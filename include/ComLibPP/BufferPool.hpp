@@ -0,0 +1,77 @@
+#ifndef COMLIBPP_BUFFERPOOL_HPP
+#define COMLIBPP_BUFFERPOOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Shared, size-classed block pool for stream buffers of large port fleets.
+    // Free lists are sharded per NUMA node: a block is handed out to threads on the
+    // node it was first touched on, and goes back to that node's list when returned.
+    class COMLIBPP_API BufferPool
+    {
+    public:
+        struct Options
+        {
+            std::size_t minBlock {512};           // smallest size class (power of two)
+            std::size_t maxBlock {256 * 1024};    // larger requests are not cached
+            std::size_t maxCachedPerClass {1024}; // per node
+        };
+
+        struct Block
+        {
+            uint8_t*    data {nullptr};
+            std::size_t size {0};
+            uint32_t    node {0};
+
+            explicit operator bool() const { return data != nullptr; }
+        };
+
+        BufferPool();
+        explicit BufferPool(const Options &options);
+        ~BufferPool();
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        // block of at least `size` bytes, rounded up to its size class; thread-safe
+        [[nodiscard]] Block borrow(std::size_t size);
+        void giveBack(Block block);
+
+        // free every cached block
+        void trim();
+
+        [[nodiscard]] std::size_t outstanding() const { return m_Outstanding.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::size_t cachedBlocks() const { return m_Cached.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::size_t kShards = 8;
+        static constexpr std::size_t kOversize = static_cast<std::size_t>(-1);
+
+        struct Shard
+        {
+            std::mutex                         mutex;
+            std::vector<std::vector<uint8_t*>> free; // per size class
+        };
+
+        [[nodiscard]] std::size_t classOf_(std::size_t size) const;
+        [[nodiscard]] std::size_t classSize_(std::size_t cls) const;
+        static uint32_t currentNode_();
+        static uint8_t* allocate_(std::size_t size);
+        static void deallocate_(uint8_t* p);
+
+    private:
+        Options                     m_Options;
+        std::size_t                 m_Classes {0};
+        std::array<Shard, kShards>  m_Shards;
+        std::atomic<std::size_t>    m_Outstanding {0};
+        std::atomic<std::size_t>    m_Cached {0};
+    };
+}
+
+#endif //COMLIBPP_BUFFERPOOL_HPP
@@ -2,15 +2,27 @@
 #define COMLIBPP_HPP
 
 
+#include <array>
 #include <cstdint>
 #include <chrono>
 #include <condition_variable>
 #include <iostream>
+#include <iterator>
+#include <optional>
 #include <streambuf>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#include "BufferPool.hpp"
 #include "ISerialDriver.hpp"
+#include "PatternMatcher.hpp"
 
 namespace ucpgr
 {
@@ -24,6 +36,91 @@ public:
     SerialStreamBuf(const SerialStreamBuf&) = delete;
     SerialStreamBuf& operator=(const SerialStreamBuf&) = delete;
 
+    // receive timestamps (off by default); enabling clears the side-table
+    void enableRxTimestamps(bool enable);
+    // stream offset of the next byte handed out by the get area
+    [[nodiscard]] uint64_t rxPosition() const;
+    // arrival time of the chunk holding byte `position` (nullopt once it aged out)
+    [[nodiscard]] std::optional<ISerialDriver::RxTimestamp> rxTimestampAt(uint64_t position) const;
+
+    // Switch the get/put areas to blocks borrowed from `pool` (which must outlive this
+    // buffer). Blocks are borrowed on first use and handed back once the area is drained
+    // and has seen no traffic for `idleRelease`; an idle port polls into a small probe.
+    void usePool(BufferPool &pool, std::chrono::milliseconds idleRelease = std::chrono::seconds{5});
+    // give back drained, idle blocks now. Not synchronised: call it from the thread that
+    // uses this stream (e.g. a housekeeping pass in the loop that drives the fleet).
+    void releaseIdle();
+    [[nodiscard]] bool holdsBuffers() const;
+
+    // TX pacing: keep at most `targetDrain` of line time (at the driver's baud) queued
+    // below us; the rest waits in the put area where it can still be dropped. 0 == off.
+    void setTxPacing(std::chrono::microseconds targetDrain);
+    // bytes written to the stream but not yet handed to the driver
+    [[nodiscard]] std::size_t txBacklog() const;
+    // drop the user-space backlog; returns bytes discarded
+    std::size_t discardOutput();
+    // Flush the put area, then hand `data` to the driver in as few writeSome calls as it
+    // takes, bypassing the put area (pacing still applies). Returns bytes written; short
+    // once the write timeout runs out.
+    std::size_t writeThrough(std::span<const uint8_t> data);
+
+    struct WaitResult
+    {
+        int              pattern {-1}; // index of the pattern that matched, -1 at the deadline
+        std::string_view before;       // bytes consumed ahead of the match; valid until the next read
+    };
+    // Consume input until one of the patterns has been read or the deadline passes.
+    // The matcher state carries across refills, so no byte is looked at twice. At the
+    // deadline, the tail that is still a pattern prefix is left unread for the next call.
+    WaitResult waitFor(std::span<const std::string_view> patterns, std::chrono::steady_clock::time_point deadline);
+    WaitResult waitFor(const PatternMatcher &matcher, std::chrono::steady_clock::time_point deadline);
+
+    // Output iterator that writes straight into the put area, flushing only when it
+    // fills. Usable with std::format_to, std::copy and friends; no sentry, no locale.
+    class PutIterator
+    {
+    public:
+        using iterator_category = std::output_iterator_tag;
+        using value_type        = void;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = void;
+
+        PutIterator() = default;
+        explicit PutIterator(SerialStreamBuf &buf) : m_Buf(&buf) {}
+
+        PutIterator& operator=(char c)
+        {
+            if (!m_Failed)
+            {
+                m_Failed = !m_Buf->put_(c);
+            }
+            return *this;
+        }
+        PutIterator& operator*() { return *this; }
+        PutIterator& operator++() { return *this; }
+        PutIterator& operator++(int) { return *this; }
+
+        // a flush failed; everything after it was dropped
+        [[nodiscard]] bool failed() const { return m_Failed; }
+
+    private:
+        SerialStreamBuf *m_Buf {nullptr};
+        bool             m_Failed {false};
+    };
+
+    PutIterator putIterator() { return PutIterator(*this); }
+
+#if defined(__cpp_lib_format)
+    // format into the put area; the format string is checked at compile time.
+    // Returns false if the driver refused data on the way.
+    template <typename ...Args>
+    bool print(std::format_string<Args...> fmt, Args &&...args)
+    {
+        return !std::format_to(putIterator(), fmt, std::forward<Args>(args)...).failed();
+    }
+#endif
+
 protected:
     int_type underflow() override; // refill get area
     int sync() override; // flush put area
@@ -34,14 +131,60 @@ protected:
     pos_type seekpos(pos_type, std::ios_base::openmode) override; // serial ports are not seekable
 
 private:
-    bool flushOut_();
+    static std::size_t bufferSizeFor_(const ISerialDriver::SerialSettings &settings);
+    bool refill_(std::chrono::milliseconds tmo);
+    bool flushOut_(bool drainAll = true);
+    std::size_t writeOut_(const uint8_t *data, std::size_t n, bool drainAll);
+    bool put_(char c)
+    {
+        if (pptr() != epptr())
+        {
+            *pptr() = c;
+            pbump(1);
+            return true;
+        }
+        return putSlow_(c);
+    }
+    bool putSlow_(char c);
+    [[nodiscard]] std::size_t txRoom_() const;
+    bool waitTxRoom_(std::chrono::steady_clock::time_point deadline, std::chrono::milliseconds tmo) const;
+    bool ensurePutArea_();
+    void releaseIdle_(std::chrono::steady_clock::time_point now);
     [[nodiscard]] std::chrono::milliseconds timeoutForRead_() const;
     [[nodiscard]] std::chrono::milliseconds timeoutForWrite_() const;
 
 private:
+    struct RxStamp
+    {
+        uint64_t                   position;
+        ISerialDriver::RxTimestamp stamp;
+    };
+    static constexpr std::size_t kRxStampSlots = 32;
+    static constexpr std::size_t kBufferSize = 4096;         // floor; scaled up with the baud rate
+    static constexpr std::size_t kMaxBufferSize = 64 * 1024;
+
     ISerialDriver           &m_Driver;
+    std::size_t              m_BufferSize;
     std::vector<uint8_t>     m_InBuf;
     std::vector<uint8_t>     m_OutBuf;
+
+    uint64_t                             m_RxTotal {0};      // bytes received since construction
+    bool                                 m_RxTimestamps {false};
+    std::size_t                          m_RxStampCount {0}; // entries ever written
+    std::array<RxStamp, kRxStampSlots>   m_RxStamps {};
+
+    BufferPool                          *m_Pool {nullptr};   // pooled mode when set
+    BufferPool::Block                    m_InBlock {};
+    BufferPool::Block                    m_OutBlock {};
+    std::chrono::milliseconds            m_IdleRelease {};
+    std::chrono::steady_clock::time_point m_LastRx {};
+    std::chrono::steady_clock::time_point m_LastTx {};
+    std::array<uint8_t, 64>              m_Probe {};
+
+    std::chrono::microseconds            m_TxPacing {0};
+
+    std::string                          m_WaitSpill;        // waitFor bytes that outlived a refill
+    std::string                          m_WaitCarry;        // unfinished match handed back at a waitFor deadline
 };
 
 
@@ -76,6 +219,19 @@ public:
         return &m_Buf;
     }
 
+#if defined(__cpp_lib_format)
+    // std::format straight into the stream buffer, bypassing sentries and facets
+    template <typename ...Args>
+    SerialStream& print(std::format_string<Args...> fmt, Args &&...args)
+    {
+        if (!m_Buf.print(fmt, std::forward<Args>(args)...))
+        {
+            setstate(std::ios::badbit);
+        }
+        return *this;
+    }
+#endif
+
 private:
     Driver m_Driver;
     SerialStreamBuf m_Buf;
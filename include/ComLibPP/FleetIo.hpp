@@ -0,0 +1,77 @@
+#ifndef COMLIBPP_FLEETIO_HPP
+#define COMLIBPP_FLEETIO_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <system_error>
+
+#include "ISerialDriver.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Batched I/O over many drivers: one readiness wait covers every descriptor-backed
+    // port in the batch, and only ports that are ready get a (non-blocking) read/write.
+    // Drivers without a descriptor are tried non-blocking on every pass.
+    class COMLIBPP_API FleetIo
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Kind : uint8_t { read, write };
+        enum class Status : uint8_t { pending, done, timedOut, failed };
+
+        struct Operation
+        {
+            ISerialDriver     *driver {nullptr};
+            Kind               kind {Kind::read};
+            uint8_t           *data {nullptr};
+            std::size_t        size {0};
+            std::size_t        minBytes {1};  // a read completes once this many bytes arrived
+            Clock::time_point  deadline {};
+            void              *user {nullptr};
+
+            // results
+            std::size_t        transferred {0};
+            Status             status {Status::pending};
+            std::error_code    error {};
+
+            static Operation read(ISerialDriver &driver, std::span<uint8_t> dst, Clock::time_point deadline, std::size_t minBytes = 1)
+            {
+                return {&driver, Kind::read, dst.data(), dst.size(), minBytes, deadline};
+            }
+
+            static Operation write(ISerialDriver &driver, std::span<const uint8_t> src, Clock::time_point deadline)
+            {
+                return {&driver, Kind::write, const_cast<uint8_t*>(src.data()), src.size(), src.size(), deadline};
+            }
+        };
+
+        using Completion = std::function<void(Operation&)>;
+
+        FleetIo();
+        ~FleetIo();
+        FleetIo(const FleetIo&) = delete;
+        FleetIo& operator=(const FleetIo&) = delete;
+
+        // one pass: expire, wait at most `maxWait` for readiness, move bytes on ready ports.
+        // Returns operations that left `pending` in this pass; onComplete sees each as it lands.
+        std::size_t step(std::span<Operation> ops, std::chrono::milliseconds maxWait, const Completion &onComplete = {});
+
+        // step until nothing is pending; returns operations that finished with Status::done
+        std::size_t run(std::span<Operation> ops, const Completion &onComplete = {});
+
+    private:
+        struct Scratch;
+
+        static bool transfer_(Operation &op);
+
+    private:
+        std::unique_ptr<Scratch> m_Scratch; // reused poll set, no per-pass allocation once warm
+    };
+}
+
+#endif //COMLIBPP_FLEETIO_HPP
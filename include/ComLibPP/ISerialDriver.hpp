@@ -5,7 +5,9 @@
 #ifndef COMLIBPP_ISERIALDRIVER_HPP
 #define COMLIBPP_ISERIALDRIVER_HPP
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <system_error>
 #include "export.hpp"
@@ -40,6 +42,31 @@ namespace ucpgr
             Parity parity{Parity::none};
             StopBits stopBits{StopBits::one};
 
+            // line time of one character (start + data + parity + stop, 1.5 rounded up)
+            [[nodiscard]] uint32_t bitsPerChar() const
+            {
+                return 1u + dataBits + (parity == Parity::none ? 0u : 1u) + (stopBits == StopBits::one ? 1u : 2u);
+            }
+
+            // whole characters the line carries in `lineTime`; at least one
+            [[nodiscard]] std::size_t bytesFor(std::chrono::microseconds lineTime) const
+            {
+                const double charsPerSecond = static_cast<double>(baud) / bitsPerChar();
+                return std::max<std::size_t>(1, static_cast<std::size_t>(
+                    charsPerSecond * std::chrono::duration<double>(lineTime).count()));
+            }
+        };
+
+        // arrival time of a chunk, captured as close to the readiness event as the driver can
+        struct RxTimestamp
+        {
+            std::chrono::steady_clock::time_point monotonic {};
+            std::chrono::system_clock::time_point realtime {};
+
+            static RxTimestamp now()
+            {
+                return {std::chrono::steady_clock::now(), std::chrono::system_clock::now()};
+            }
         };
 
         virtual ~ISerialDriver() = default;
@@ -57,6 +84,16 @@ namespace ucpgr
         virtual std::size_t readSome(uint8_t* dst, std::size_t maxBytes,
                                      std::chrono::milliseconds timeout) = 0;
 
+        // readSome + arrival time; stamp is only meaningful when bytes were read.
+        // Default stamps on return, drivers that see the readiness event override.
+        virtual std::size_t readSomeTimestamped(uint8_t* dst, std::size_t maxBytes,
+                                                std::chrono::milliseconds timeout, RxTimestamp &stamp)
+        {
+            const std::size_t got = readSome(dst, maxBytes, timeout);
+            stamp = RxTimestamp::now();
+            return got;
+        }
+
         // write up to n; returns bytes written (0 == timeout/non-blocking cannot write)
         virtual std::size_t writeSome(const uint8_t* src, std::size_t n,
                                       std::chrono::milliseconds timeout) = 0;
@@ -64,9 +101,22 @@ namespace ucpgr
         // hint: bytes available to read without blocking (best-effort)
         [[nodiscard]] virtual std::size_t bytesAvailable() const = 0;
 
+        // hint: bytes accepted by writeSome but not yet on the line (best-effort, 0 == unknown)
+        [[nodiscard]] virtual std::size_t bytesPending() const
+        {
+            return 0;
+        }
+
         // cancel any blocking I/O (e.g., from another thread)
         virtual void cancelIo() = 0;
 
+        // hint: POSIX descriptor that polls readable/writable with this driver (-1 == none),
+        // lets FleetIo multiplex many ports in one wait
+        [[nodiscard]] virtual int pollDescriptor() const
+        {
+            return -1;
+        }
+
         const virtual TimeoutPolicy& getTimeoutPolicy() const = 0;
         const virtual SerialSettings& getSerialSettings() const = 0;
 
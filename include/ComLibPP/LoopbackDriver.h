@@ -5,6 +5,8 @@
 #ifndef COMLIBPP_LOOPBACKDRIVER_H
 #define COMLIBPP_LOOPBACKDRIVER_H
 
+#include <string>
+#include <vector>
 #include "ISerialDriver.hpp"
 
 namespace ucpgr
@@ -25,6 +27,8 @@ namespace ucpgr
         std::size_t writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds) override;
 
         [[nodiscard]] std::size_t bytesAvailable() const override;
+        // modelled: written bytes drain at the configured baud rate
+        [[nodiscard]] std::size_t bytesPending() const override;
         void cancelIo() override;
 
     private:
@@ -34,6 +38,8 @@ namespace ucpgr
 
     private:
         std::vector<uint8_t> m_Buffer;
+        std::size_t m_TxQueued{0};
+        std::chrono::steady_clock::time_point m_TxQueuedAt{};
         bool m_IsOpen{false};
         TimeoutPolicy   m_Policy {};
         SerialSettings  m_Settings {};
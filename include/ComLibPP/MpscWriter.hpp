@@ -0,0 +1,92 @@
+#ifndef COMLIBPP_MPSCWRITER_HPP
+#define COMLIBPP_MPSCWRITER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "ComLibPP.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Multi-producer write front end for one SerialStreamBuf. Producers reserve whole
+    // records in a byte ring with a CAS on the tail and publish them with a per-record
+    // stamp; no lock is taken on submit. Whoever wins the flush flag copies every
+    // committed record out in one pass and hands the batch straight to the driver, so
+    // a burst from many threads leaves as one write. Records leave the ring before the
+    // write: if the driver's write timeout cuts a batch short, the rest is lost and
+    // shortWrites() counts it.
+    class COMLIBPP_API MpscWriter
+    {
+    public:
+        enum class FullPolicy : uint8_t { block, failFast, dropOldest };
+
+        struct Options
+        {
+            std::size_t ringBytes {64 * 1024};      // rounded up to a power of two
+            FullPolicy  policy {FullPolicy::block};
+            bool        flushOnSubmit {true};       // false: some thread calls flush()
+        };
+
+        explicit MpscWriter(SerialStreamBuf &out);
+        MpscWriter(SerialStreamBuf &out, const Options &options);
+        MpscWriter(const MpscWriter&) = delete;
+        MpscWriter& operator=(const MpscWriter&) = delete;
+
+        // Queue one message; it reaches the stream whole and in reservation order.
+        // false when it can never fit, or the ring is full under failFast. Thread-safe.
+        bool submit(std::span<const uint8_t> message);
+
+        // write out everything committed; returns bytes handed to the stream.
+        // Returns at once if another thread is already flushing. Thread-safe.
+        std::size_t flush();
+
+        [[nodiscard]] std::size_t pendingBytes() const;
+        [[nodiscard]] uint64_t droppedMessages() const { return m_Dropped.load(std::memory_order_relaxed); }
+        [[nodiscard]] uint64_t shortWrites() const { return m_ShortWrites.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::size_t kAlign = 16;
+        static constexpr std::size_t kHeader = 8;  // uint32 length + uint32 reserved
+        static constexpr std::size_t kWord = sizeof(uint64_t);
+        static_assert(std::atomic_ref<uint64_t>::required_alignment <= alignof(uint64_t));
+
+        [[nodiscard]] static uint64_t recordSize_(std::size_t length)
+        {
+            return (kHeader + length + kAlign - 1) & ~uint64_t{kAlign - 1};
+        }
+        [[nodiscard]] std::atomic<uint64_t>& stamp_(uint64_t position) const
+        {
+            return m_Stamps[(position & m_Mask) / kAlign];
+        }
+        // Ring access is by whole 64-bit words through atomic_ref: drain_ and dropOldest_
+        // read optimistically and may race a producer refilling the same space (their
+        // CAS on head then fails). Positions are always word aligned.
+        void copyIn_(uint64_t position, const uint8_t *src, std::size_t n);
+        void copyOut_(uint64_t position, uint8_t *dst, std::size_t n) const;
+        bool reserve_(uint64_t size, uint64_t &position);
+        bool dropOldest_(uint64_t head);
+        [[nodiscard]] bool committedAtHead_() const;
+        std::size_t drain_();
+
+    private:
+        SerialStreamBuf                            &m_Out;
+        Options                                     m_Options;
+        uint64_t                                    m_Capacity;
+        uint64_t                                    m_Mask;
+        std::unique_ptr<uint64_t[]>                 m_Ring;
+        std::unique_ptr<std::atomic<uint64_t>[]>    m_Stamps;    // one per cell: position + 1 once committed
+        std::vector<uint8_t>                        m_Staging;   // flusher only
+
+        alignas(64) std::atomic<uint64_t>           m_Tail {0};  // next free byte (reservations)
+        alignas(64) std::atomic<uint64_t>           m_Head {0};  // oldest byte still owned by the ring
+        alignas(64) std::atomic_flag                m_Flushing;
+        std::atomic<uint64_t>                       m_Dropped {0};
+        std::atomic<uint64_t>                       m_ShortWrites {0};
+    };
+}
+
+#endif //COMLIBPP_MPSCWRITER_HPP
@@ -0,0 +1,62 @@
+#ifndef COMLIBPP_PATTERNMATCHER_HPP
+#define COMLIBPP_PATTERNMATCHER_HPP
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Aho-Corasick automaton for a fixed set of byte patterns, compiled to a dense
+    // DFA over the byte classes that occur in the patterns. Matching is one table
+    // lookup per byte and the state survives across buffer refills.
+    class COMLIBPP_API PatternMatcher
+    {
+    public:
+        using State = uint32_t;
+        static constexpr State kStart = 0;
+
+        explicit PatternMatcher(std::span<const std::string_view> patterns);
+
+        [[nodiscard]] State step(State state, uint8_t byte) const
+        {
+            return m_Next[state * m_Classes + m_ClassOf[byte]];
+        }
+
+        // pattern that ends in `state` (lowest index wins), -1 if none
+        [[nodiscard]] int match(State state) const
+        {
+            return m_Match[state];
+        }
+
+        // bytes of a pattern prefix that `state` stands for (0 at kStart)
+        [[nodiscard]] std::size_t depth(State state) const
+        {
+            return m_Depth[state];
+        }
+
+        [[nodiscard]] std::size_t patternLength(int pattern) const
+        {
+            return m_Lengths[static_cast<std::size_t>(pattern)];
+        }
+
+        [[nodiscard]] std::size_t patternCount() const
+        {
+            return m_Lengths.size();
+        }
+
+    private:
+        std::array<uint16_t, 256> m_ClassOf {};  // 0 == byte not in any pattern
+        std::size_t               m_Classes {1};
+        std::vector<State>        m_Next;        // states x classes
+        std::vector<int>          m_Match;
+        std::vector<std::size_t>  m_Depth;
+        std::vector<std::size_t>  m_Lengths;
+    };
+}
+
+#endif //COMLIBPP_PATTERNMATCHER_HPP
@@ -0,0 +1,77 @@
+#ifndef COMLIBPP_POSIXSERIALDRIVER_HPP
+#define COMLIBPP_POSIXSERIALDRIVER_HPP
+
+// =====================================================================
+// Linux tty driver (termios2, so any baud rate the hardware can divide to)
+// =====================================================================
+#ifdef __linux__
+
+#include <atomic>
+#include <string>
+
+#include "ISerialDriver.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // portName is a device path ("/dev/ttyUSB0", "/dev/serial/by-id/...").
+    // The rate goes to the kernel as BOTHER, so 2/3/6/12 Mbaud and odd rates work wherever
+    // the UART or USB bridge can divide to them; actualBaud() is what the driver accepted.
+    // On open the port is switched to low-latency mode (ASYNC_LOW_LATENCY, and a 1 ms
+    // latency timer on FTDI bridges) where the kernel lets us.
+    class COMLIBPP_API PosixSerial final : public ISerialDriver
+    {
+    public:
+        explicit PosixSerial(std::string portName, const SerialSettings &settings = {}, const TimeoutPolicy &timeoutPolicy = {});
+        PosixSerial(std::string portName, uint32_t baud);
+        ~PosixSerial() override;
+        PosixSerial(const PosixSerial&) = delete;
+        PosixSerial& operator=(const PosixSerial&) = delete;
+
+        void open(std::string portName, const SerialSettings &settings, const TimeoutPolicy &timeoutPolicy) override;
+        void open(std::string portName, uint32_t baud) override;
+        [[nodiscard]] bool isOpen() const override;
+        void close() override;
+        void setLineCoding(const SerialSettings &settings) override;
+        void setTimeouts(const TimeoutPolicy& policy) override;
+        std::size_t readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout) override;
+        std::size_t readSomeTimestamped(uint8_t* dst, std::size_t maxBytes,
+                                        std::chrono::milliseconds timeout, RxTimestamp &stamp) override;
+        std::size_t writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds timeout) override;
+
+        [[nodiscard]] std::size_t bytesAvailable() const override;
+        [[nodiscard]] std::size_t bytesPending() const override;
+        void cancelIo() override;
+        [[nodiscard]] int pollDescriptor() const override;
+
+        const TimeoutPolicy& getTimeoutPolicy() const override;
+        const SerialSettings& getSerialSettings() const override;
+
+        // output rate read back from the kernel after the last setLineCoding
+        [[nodiscard]] uint32_t actualBaud() const { return m_ActualBaud; }
+        // true if either low-latency knob took effect
+        [[nodiscard]] bool lowLatency() const { return m_LowLatency; }
+
+    private:
+        std::size_t read_(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout, RxTimestamp *stamp);
+        void enableLowLatency_(const std::string &portName);
+        // POLLIN/POLLOUT on the tty; false on timeout, or on a cancelIo after the
+        // operation read `cancelGen`
+        bool waitPort_(short events, std::chrono::milliseconds timeout, uint32_t cancelGen);
+        [[noreturn]] static void throwErrno_(const char* what);
+
+    private:
+        int             m_Fd {-1};
+        int             m_WakeRead {-1};
+        int             m_WakeWrite {-1};
+        std::atomic<uint32_t> m_CancelGen {0};
+        TimeoutPolicy   m_Policy {};
+        SerialSettings  m_Settings {};
+        uint32_t        m_ActualBaud {0};
+        bool            m_LowLatency {false};
+    };
+}
+
+#endif // __linux__
+
+#endif //COMLIBPP_POSIXSERIALDRIVER_HPP
@@ -0,0 +1,92 @@
+#ifndef COMLIBPP_RFC2217DRIVER_HPP
+#define COMLIBPP_RFC2217DRIVER_HPP
+
+// =====================================================================
+// RFC 2217 (telnet COM-PORT-OPTION) client over TCP, POSIX sockets
+// =====================================================================
+#ifndef _WIN32
+
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+
+#include "ISerialDriver.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // portName is "host:port" (optionally prefixed with "rfc2217://", IPv6 as "[addr]:port").
+    // Line coding goes to the terminal server as COM-PORT-OPTION subnegotiation; timeouts
+    // have no RFC 2217 equivalent and are applied locally to the socket waits (connect
+    // included: it gives up after writeTimeout unless the policy is blocking).
+    //
+    // writeSome returns what reached the socket within its timeout. Commands queued by
+    // setLineCoding leave in the same send() as the next data (or with the next read);
+    // bytesPending() counts them.
+    class COMLIBPP_API Rfc2217Driver final : public ISerialDriver
+    {
+    public:
+        explicit Rfc2217Driver(std::string portName, const SerialSettings &settings = {}, const TimeoutPolicy &timeoutPolicy = {});
+        Rfc2217Driver(std::string portName, uint32_t baud);
+        ~Rfc2217Driver() override;
+        Rfc2217Driver(const Rfc2217Driver&) = delete;
+        Rfc2217Driver& operator=(const Rfc2217Driver&) = delete;
+
+        void open(std::string portName, const SerialSettings &settings, const TimeoutPolicy &timeoutPolicy) override;
+        void open(std::string portName, uint32_t baud) override;
+        [[nodiscard]] bool isOpen() const override;
+        void close() override;
+        void setLineCoding(const SerialSettings &settings) override;
+        void setTimeouts(const TimeoutPolicy& policy) override;
+        std::size_t readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout) override;
+        std::size_t readSomeTimestamped(uint8_t* dst, std::size_t maxBytes,
+                                        std::chrono::milliseconds timeout, RxTimestamp &stamp) override;
+        std::size_t writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds timeout) override;
+
+        [[nodiscard]] std::size_t bytesAvailable() const override;
+        [[nodiscard]] std::size_t bytesPending() const override;
+        void cancelIo() override;
+        [[nodiscard]] int pollDescriptor() const override;
+
+        const TimeoutPolicy& getTimeoutPolicy() const override;
+        const SerialSettings& getSerialSettings() const override;
+
+        // line coding as last acknowledged by the server (updated while reading)
+        [[nodiscard]] const SerialSettings& getConfirmedSettings() const;
+
+    private:
+        enum class RxState : uint8_t { data, iac, option, sub, subIac };
+
+        std::size_t read_(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout, RxTimestamp *stamp);
+        std::size_t decode_(uint8_t* buf, std::size_t n);
+        void handleOption_(uint8_t verb, uint8_t option);
+        void handleSubnegotiation_();
+        void queueComPort_(uint8_t command, const uint8_t* value, std::size_t n);
+        // true once the whole queue is in the socket
+        bool flushTx_(std::chrono::milliseconds timeout);
+        // revents of the socket; 0 on timeout or cancelIo
+        short waitSocket_(short events, std::chrono::milliseconds timeout);
+        // a cancelIo with nothing blocked must not cut the next operation short
+        void clearCancel_();
+        // non-blocking connect bounded by timeout; errno value, 0 on success
+        static int connect_(int fd, const sockaddr* addr, socklen_t len, std::chrono::milliseconds timeout);
+        [[noreturn]] static void throwErrno_(const char* what);
+
+    private:
+        int                  m_Socket {-1};
+        int                  m_WakeRead {-1};
+        int                  m_WakeWrite {-1};
+        TimeoutPolicy        m_Policy {};
+        SerialSettings       m_Settings {};
+        SerialSettings       m_Confirmed {};
+
+        RxState              m_RxState {RxState::data};
+        uint8_t              m_RxVerb {0};
+        std::vector<uint8_t> m_SubNeg;
+        std::vector<uint8_t> m_Tx;        // escaped bytes not yet in the socket (control first)
+    };
+}
+
+#endif // _WIN32
+
+#endif //COMLIBPP_RFC2217DRIVER_HPP
@@ -0,0 +1,450 @@
+#ifndef COMLIBPP_RXPIPELINE_HPP
+#define COMLIBPP_RXPIPELINE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ISerialDriver.hpp"
+
+namespace ucpgr
+{
+    // Parallel receive path. One thread owns the driver, cuts the stream into frames
+    // and batches them into chunks; a pool of workers decodes chunks concurrently and
+    // the consumer gets the results back in wire order.
+    //
+    // The chunk ring is the only queue: each slot carries a stamp (sequence * 4 + phase)
+    // that moves free -> filled -> decoded -> free, so no stage takes a lock on the data
+    // path. When every slot is in flight the reader stops reading and the driver's own
+    // buffering (and flow control) takes the backpressure.
+    //
+    //   framer(bytes)  -> length of the complete frame at the front, 0 if more bytes are needed
+    //   decoder(frame) -> Result; an exception takes that frame's place in the output and
+    //                     is rethrown by pop(), later frames are still delivered
+    template <typename Result>
+    class RxPipeline
+    {
+    public:
+        using Framer = std::function<std::size_t(std::span<const uint8_t>)>;
+        using Decoder = std::function<Result(std::span<const uint8_t>)>;
+
+        struct Options
+        {
+            std::size_t workers {0};                     // 0 == hardware threads - 1 (at least 1)
+            std::size_t window {32};                     // chunks in flight before the reader stalls
+            std::size_t chunkBytes {16 * 1024};          // a chunk is closed once it holds this much
+            std::size_t readBytes {4096};
+            std::size_t maxFrameBytes {64 * 1024};       // unframed bytes beyond this go to the decoder as-is
+            std::chrono::milliseconds readTimeout {50};  // also bounds how long stop() waits for the reader
+        };
+
+        // cumulative counters; sample twice and divide by the interval for rates
+        struct Metrics
+        {
+            uint64_t bytesRead {0};
+            uint64_t framesSliced {0};
+            uint64_t chunksPublished {0};
+            uint64_t chunksDecoded {0};
+            uint64_t resultsDelivered {0};
+            uint64_t readerStalls {0};                   // times the reader waited for a free slot
+            std::chrono::nanoseconds readerStalled {0};  // ... and for how long (completed waits)
+            std::chrono::nanoseconds decodeBusy {0};     // summed over all workers
+            std::size_t inFlight {0};                    // chunks published but not yet consumed
+        };
+
+        RxPipeline(ISerialDriver &driver, Framer framer, Decoder decoder)
+            : RxPipeline(driver, std::move(framer), std::move(decoder), Options{})
+        {
+        }
+
+        RxPipeline(ISerialDriver &driver, Framer framer, Decoder decoder, const Options &options)
+            : m_Driver(driver), m_Framer(std::move(framer)), m_Decoder(std::move(decoder)), m_Options(options),
+              m_Slots(std::max<std::size_t>(options.window, 1))
+        {
+            for (std::size_t i = 0; i < m_Slots.size(); ++i)
+            {
+                m_Slots[i].stamp.store(stamp_(i, kFree), std::memory_order_relaxed);
+            }
+
+            std::size_t workers = m_Options.workers;
+            if (workers == 0)
+            {
+                workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+            }
+            for (std::size_t i = 0; i < workers; ++i)
+            {
+                m_Workers.emplace_back([this] { decodeLoop_(); });
+            }
+            m_Reader = std::thread([this] { readLoop_(); });
+        }
+
+        ~RxPipeline()
+        {
+            stop();
+        }
+
+        RxPipeline(const RxPipeline&) = delete;
+        RxPipeline& operator=(const RxPipeline&) = delete;
+
+        // stops all stages; results not yet consumed are discarded
+        void stop()
+        {
+            if (m_Stop.exchange(true))
+            {
+                return;
+            }
+            m_Driver.cancelIo();
+            for (Slot &slot : m_Slots)
+            {
+                // a value change is what wakes atomic waiters
+                slot.stamp.fetch_or(kStopBit);
+                slot.stamp.notify_all();
+            }
+            wakeConsumer_();
+
+            if (m_Reader.joinable())
+            {
+                m_Reader.join();
+            }
+            for (std::thread &worker : m_Workers)
+            {
+                worker.join();
+            }
+        }
+
+        // next result in wire order without waiting; rethrows decoder and driver errors
+        std::optional<Result> poll()
+        {
+            return pop(std::chrono::milliseconds{0});
+        }
+
+        // next result in wire order, waiting up to `timeout` (<0 == forever);
+        // nullopt on timeout or once the pipeline is stopped and drained. Call from one thread.
+        std::optional<Result> pop(std::chrono::milliseconds timeout)
+        {
+            const bool infinite = timeout.count() < 0;
+            const auto deadline = std::chrono::steady_clock::now() + std::max(timeout, std::chrono::milliseconds{0});
+
+            for (;;)
+            {
+                Slot &slot = slot_(m_Delivered);
+                if (slot.stamp.load(std::memory_order_acquire) == stamp_(m_Delivered, kDecoded))
+                {
+                    if (m_Cursor < slot.outcomes.size())
+                    {
+                        Outcome &outcome = slot.outcomes[m_Cursor++];
+                        if (outcome.error)
+                        {
+                            std::rethrow_exception(std::exchange(outcome.error, nullptr));
+                        }
+                        m_ResultsDelivered.fetch_add(1, std::memory_order_relaxed);
+                        return std::move(outcome.value);
+                    }
+                    release_(slot);
+                    continue;
+                }
+
+                if (m_Stop.load(std::memory_order_acquire))
+                {
+                    return std::nullopt;
+                }
+                if (m_ReaderDone.load(std::memory_order_acquire) &&
+                    m_Delivered == m_Published.load(std::memory_order_acquire))
+                {
+                    if (m_ReaderError)
+                    {
+                        std::rethrow_exception(std::exchange(m_ReaderError, nullptr));
+                    }
+                    return std::nullopt;
+                }
+                if (timeout.count() == 0)
+                {
+                    return std::nullopt;
+                }
+
+                std::unique_lock lock(m_WakeMutex);
+                m_ConsumerWaiting.store(true, std::memory_order_seq_cst);
+                const auto ready = [&] {
+                    return slot.stamp.load(std::memory_order_seq_cst) == stamp_(m_Delivered, kDecoded) ||
+                           m_Stop.load(std::memory_order_seq_cst) ||
+                           (m_ReaderDone.load(std::memory_order_seq_cst) &&
+                            m_Delivered == m_Published.load(std::memory_order_acquire));
+                };
+                bool woke = true;
+                if (infinite)
+                {
+                    m_WakeCv.wait(lock, ready);
+                }
+                else
+                {
+                    woke = m_WakeCv.wait_until(lock, deadline, ready);
+                }
+                m_ConsumerWaiting.store(false, std::memory_order_relaxed);
+                if (!woke)
+                {
+                    return std::nullopt;
+                }
+            }
+        }
+
+        [[nodiscard]] Metrics metrics() const
+        {
+            Metrics m;
+            m.bytesRead = m_BytesRead.load(std::memory_order_relaxed);
+            m.framesSliced = m_FramesSliced.load(std::memory_order_relaxed);
+            m.chunksPublished = m_Published.load(std::memory_order_relaxed);
+            m.chunksDecoded = m_ChunksDecoded.load(std::memory_order_relaxed);
+            m.resultsDelivered = m_ResultsDelivered.load(std::memory_order_relaxed);
+            m.readerStalls = m_ReaderStalls.load(std::memory_order_relaxed);
+            m.readerStalled = std::chrono::nanoseconds{m_ReaderStalledNs.load(std::memory_order_relaxed)};
+            m.decodeBusy = std::chrono::nanoseconds{m_DecodeBusyNs.load(std::memory_order_relaxed)};
+            m.inFlight = static_cast<std::size_t>(m.chunksPublished - m_Released.load(std::memory_order_relaxed));
+            return m;
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr uint64_t kFree = 0;
+        static constexpr uint64_t kFilled = 1;
+        static constexpr uint64_t kDecoded = 2;
+        static constexpr uint64_t kStopBit = uint64_t{1} << 63;
+
+        // one per frame: the decoded value, or what the decoder threw
+        struct Outcome
+        {
+            std::optional<Result> value;
+            std::exception_ptr    error;
+        };
+
+        struct Slot
+        {
+            alignas(64) std::atomic<uint64_t> stamp {0};
+            std::vector<uint8_t>     bytes;
+            std::vector<std::size_t> ends;     // frame end offsets into bytes
+            std::vector<Outcome>     outcomes;
+        };
+
+        static uint64_t stamp_(uint64_t sequence, uint64_t phase)
+        {
+            return sequence * 4 + phase;
+        }
+
+        Slot& slot_(uint64_t sequence)
+        {
+            return m_Slots[static_cast<std::size_t>(sequence % m_Slots.size())];
+        }
+
+        // false once stopped
+        bool awaitStamp_(Slot &slot, uint64_t wanted)
+        {
+            for (;;)
+            {
+                const uint64_t seen = slot.stamp.load(std::memory_order_acquire);
+                if (seen == wanted)
+                {
+                    return true;
+                }
+                if ((seen & kStopBit) || m_Stop.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                slot.stamp.wait(seen, std::memory_order_acquire);
+            }
+        }
+
+        void wakeConsumer_()
+        {
+            if (m_ConsumerWaiting.load(std::memory_order_seq_cst))
+            {
+                std::lock_guard lock(m_WakeMutex);
+                m_WakeCv.notify_one();
+            }
+        }
+
+        Slot* claim_()
+        {
+            const uint64_t sequence = m_Published.load(std::memory_order_relaxed);
+            Slot &slot = slot_(sequence);
+            if (slot.stamp.load(std::memory_order_acquire) != stamp_(sequence, kFree))
+            {
+                m_ReaderStalls.fetch_add(1, std::memory_order_relaxed);
+                const auto start = Clock::now();
+                const bool ok = awaitStamp_(slot, stamp_(sequence, kFree));
+                m_ReaderStalledNs.fetch_add(static_cast<uint64_t>((Clock::now() - start).count()), std::memory_order_relaxed);
+                if (!ok)
+                {
+                    return nullptr;
+                }
+            }
+            slot.bytes.clear();
+            slot.ends.clear();
+            return &slot;
+        }
+
+        void publish_(Slot &slot)
+        {
+            const uint64_t sequence = m_Published.load(std::memory_order_relaxed);
+            slot.stamp.store(stamp_(sequence, kFilled), std::memory_order_release);
+            slot.stamp.notify_all();
+            m_Published.store(sequence + 1, std::memory_order_release);
+        }
+
+        void release_(Slot &slot)
+        {
+            slot.outcomes.clear();
+            m_Cursor = 0;
+            const uint64_t next = m_Delivered + m_Slots.size();
+            ++m_Delivered;
+            m_Released.store(m_Delivered, std::memory_order_relaxed);
+            slot.stamp.store(stamp_(next, kFree), std::memory_order_release);
+            slot.stamp.notify_all();
+        }
+
+        void readLoop_()
+        {
+            try
+            {
+                std::vector<uint8_t> carry;  // bytes not yet cut into a frame
+                while (!m_Stop.load(std::memory_order_acquire))
+                {
+                    const std::size_t kept = carry.size();
+                    carry.resize(kept + m_Options.readBytes);
+                    const std::size_t got = m_Driver.readSome(carry.data() + kept, m_Options.readBytes, m_Options.readTimeout);
+                    carry.resize(kept + got);
+                    if (got == 0)
+                    {
+                        continue;
+                    }
+                    m_BytesRead.fetch_add(got, std::memory_order_relaxed);
+
+                    Slot *slot = nullptr;
+                    std::size_t at = 0;
+                    for (;;)
+                    {
+                        const std::span<const uint8_t> rest(carry.data() + at, carry.size() - at);
+                        std::size_t length = rest.empty() ? 0 : m_Framer(rest);
+                        if (length == 0 && rest.size() >= m_Options.maxFrameBytes)
+                        {
+                            length = rest.size();
+                        }
+                        if (length == 0)
+                        {
+                            break;
+                        }
+                        length = std::min(length, rest.size());
+
+                        if (!slot && !(slot = claim_()))
+                        {
+                            return;
+                        }
+                        slot->bytes.insert(slot->bytes.end(), rest.begin(), rest.begin() + static_cast<std::ptrdiff_t>(length));
+                        slot->ends.push_back(slot->bytes.size());
+                        at += length;
+                        m_FramesSliced.fetch_add(1, std::memory_order_relaxed);
+
+                        if (slot->bytes.size() >= m_Options.chunkBytes)
+                        {
+                            publish_(*slot);
+                            slot = nullptr;
+                        }
+                    }
+                    // whatever one read completed goes out now: latency over chunk size
+                    if (slot)
+                    {
+                        publish_(*slot);
+                    }
+                    carry.erase(carry.begin(), carry.begin() + static_cast<std::ptrdiff_t>(at));
+                }
+            }
+            catch (...)
+            {
+                m_ReaderError = std::current_exception();
+            }
+            m_ReaderDone.store(true, std::memory_order_seq_cst);
+            wakeConsumer_();
+        }
+
+        void decodeLoop_()
+        {
+            for (;;)
+            {
+                const uint64_t sequence = m_NextDecode.fetch_add(1, std::memory_order_relaxed);
+                Slot &slot = slot_(sequence);
+                if (!awaitStamp_(slot, stamp_(sequence, kFilled)))
+                {
+                    return;
+                }
+
+                const auto start = Clock::now();
+                slot.outcomes.resize(slot.ends.size());
+                std::size_t begin = 0;
+                for (std::size_t i = 0; i < slot.ends.size(); ++i)
+                {
+                    // a bad frame only costs its own result
+                    try
+                    {
+                        slot.outcomes[i].value.emplace(m_Decoder(std::span<const uint8_t>(slot.bytes.data() + begin, slot.ends[i] - begin)));
+                    }
+                    catch (...)
+                    {
+                        slot.outcomes[i].error = std::current_exception();
+                    }
+                    begin = slot.ends[i];
+                }
+                m_DecodeBusyNs.fetch_add(static_cast<uint64_t>((Clock::now() - start).count()), std::memory_order_relaxed);
+                m_ChunksDecoded.fetch_add(1, std::memory_order_relaxed);
+
+                slot.stamp.store(stamp_(sequence, kDecoded), std::memory_order_seq_cst);
+                wakeConsumer_();
+            }
+        }
+
+    private:
+        ISerialDriver            &m_Driver;
+        Framer                    m_Framer;
+        Decoder                   m_Decoder;
+        Options                   m_Options;
+        std::vector<Slot>         m_Slots;
+
+        // reader
+        alignas(64) std::atomic<uint64_t> m_Published {0};
+        std::atomic<uint64_t>     m_BytesRead {0};
+        std::atomic<uint64_t>     m_FramesSliced {0};
+        std::atomic<uint64_t>     m_ReaderStalls {0};
+        std::atomic<uint64_t>     m_ReaderStalledNs {0};
+        std::atomic<bool>         m_ReaderDone {false};
+        std::exception_ptr        m_ReaderError;
+
+        // workers
+        alignas(64) std::atomic<uint64_t> m_NextDecode {0};
+        std::atomic<uint64_t>     m_ChunksDecoded {0};
+        std::atomic<uint64_t>     m_DecodeBusyNs {0};
+
+        // consumer
+        alignas(64) uint64_t      m_Delivered {0};
+        std::size_t               m_Cursor {0};
+        std::atomic<uint64_t>     m_Released {0};
+        std::atomic<uint64_t>     m_ResultsDelivered {0};
+        std::atomic<bool>         m_ConsumerWaiting {false};
+        std::mutex                m_WakeMutex;
+        std::condition_variable   m_WakeCv;
+
+        std::atomic<bool>         m_Stop {false};
+        std::thread               m_Reader;
+        std::vector<std::thread>  m_Workers;
+    };
+}
+
+#endif //COMLIBPP_RXPIPELINE_HPP
@@ -0,0 +1,91 @@
+#ifndef COMLIBPP_SHAREDMEMORYDRIVER_HPP
+#define COMLIBPP_SHAREDMEMORYDRIVER_HPP
+
+// =====================================================================
+// Cross-process "serial line" over shared memory (Linux: shm/memfd + futex)
+// =====================================================================
+#ifdef __linux__
+
+#include <atomic>
+#include <span>
+#include <string>
+
+#include "ISerialDriver.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Two lock-free SPSC byte rings in one shared mapping, one per direction.
+    // Endpoint a creates the mapping, endpoint b attaches to it. portName is
+    //   "/name"         POSIX shared memory object (a unlinks it on close)
+    //   "memfd:label"   anonymous memfd, hand descriptor() to the peer (a only)
+    //   "fd:N"          adopt an inherited descriptor, e.g. a memfd passed across exec
+    // Waits are futexes on the ring counters and honour TimeoutPolicy and cancelIo.
+    class COMLIBPP_API SharedMemoryDriver final : public ISerialDriver
+    {
+    public:
+        enum class Endpoint : uint8_t { a, b };
+
+        static constexpr std::size_t kDefaultRingBytes = 1 << 20;
+
+        SharedMemoryDriver(std::string portName, Endpoint endpoint, const SerialSettings &settings = {},
+                           const TimeoutPolicy &timeoutPolicy = {}, std::size_t ringBytes = kDefaultRingBytes);
+        ~SharedMemoryDriver() override;
+        SharedMemoryDriver(const SharedMemoryDriver&) = delete;
+        SharedMemoryDriver& operator=(const SharedMemoryDriver&) = delete;
+
+        void open(std::string portName, const SerialSettings &settings, const TimeoutPolicy &timeoutPolicy) override;
+        void open(std::string portName, uint32_t baud) override;
+        [[nodiscard]] bool isOpen() const override;
+        void close() override;
+        void setLineCoding(const SerialSettings &settings) override;
+        void setTimeouts(const TimeoutPolicy& policy) override;
+        std::size_t readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout) override;
+        std::size_t writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds timeout) override;
+
+        [[nodiscard]] std::size_t bytesAvailable() const override;
+        [[nodiscard]] std::size_t bytesPending() const override; // written, not yet read by the peer
+        void cancelIo() override;
+
+        const TimeoutPolicy& getTimeoutPolicy() const override;
+        const SerialSettings& getSerialSettings() const override;
+
+        // zero-copy receive: contiguous readable bytes in the mapping, then consume() them
+        [[nodiscard]] std::span<const uint8_t> readableRegion() const;
+        void consume(std::size_t n);
+
+        // mapping descriptor, for handing a memfd to the peer process
+        [[nodiscard]] int descriptor() const { return m_Fd; }
+
+    private:
+        struct Ring;
+        struct Shared;
+
+        // futex wait until `word` moves off `seen`, a cancel, or the deadline; false on timeout/cancel
+        bool wait_(std::atomic<uint32_t> &word, uint32_t seen, std::chrono::steady_clock::time_point deadline,
+                   bool infinite, uint32_t cancelGen);
+        static void wake_(std::atomic<uint32_t> &word);
+        [[noreturn]] static void throwErrno_(const char* what);
+
+    private:
+        Endpoint               m_Endpoint;
+        std::size_t            m_RingBytes;
+        std::string            m_Unlink;          // shm name to remove on close (endpoint a)
+        int                    m_Fd {-1};
+        void                  *m_Map {nullptr};
+        std::size_t            m_MapSize {0};
+        Shared                *m_Shared {nullptr};
+        Ring                  *m_Rx {nullptr};
+        Ring                  *m_Tx {nullptr};
+        uint8_t               *m_RxData {nullptr};
+        uint8_t               *m_TxData {nullptr};
+        uint32_t               m_Capacity {0};
+        std::atomic<uint32_t>  m_CancelGen {0};
+        TimeoutPolicy          m_Policy {};
+        SerialSettings         m_Settings {};
+    };
+}
+
+#endif // __linux__
+
+#endif //COMLIBPP_SHAREDMEMORYDRIVER_HPP
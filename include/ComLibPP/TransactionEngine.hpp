@@ -0,0 +1,121 @@
+#ifndef COMLIBPP_TRANSACTIONENGINE_HPP
+#define COMLIBPP_TRANSACTIONENGINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "ISerialDriver.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Pipelined request/response over a driver for devices that accept several tagged
+    // requests at once. Up to `window` transactions are on the wire; responses are cut
+    // with `framer` and matched back by the key `keyOf` extracts, in whatever order they
+    // arrive. Each transaction has its own deadline and retry budget.
+    //
+    //   framer(bytes) -> length of the complete frame at the front, 0 if more bytes are needed
+    //   keyOf(frame)  -> key of the request it answers; nullopt for unsolicited frames
+    class COMLIBPP_API TransactionEngine
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Key = uint64_t;
+        using Framer = std::function<std::size_t(std::span<const uint8_t>)>;
+        using KeyOf = std::function<std::optional<Key>(std::span<const uint8_t>)>;
+
+        enum class Status : uint8_t { ok, timedOut, cancelled };
+
+        struct Result
+        {
+            Status                   status {Status::cancelled};
+            std::vector<uint8_t>     response;
+            std::chrono::nanoseconds latency {0};  // submit to response (or giving up)
+            std::chrono::nanoseconds queued {0};   // part of latency spent before the first send
+            uint32_t                 attempts {0};
+        };
+        using Callback = std::function<void(Result&&)>;
+
+        struct Limits
+        {
+            std::chrono::milliseconds timeout {500};  // per attempt
+            uint32_t retries {2};
+        };
+
+        struct Options
+        {
+            std::size_t window {8};                 // transactions in flight
+            Limits limits {};                       // default for submit() without limits
+            std::size_t readBytes {4096};
+            std::size_t maxFrameBytes {64 * 1024};  // unframed input beyond this is discarded
+        };
+
+        TransactionEngine(ISerialDriver &driver, Framer framer, KeyOf keyOf);
+        TransactionEngine(ISerialDriver &driver, Framer framer, KeyOf keyOf, const Options &options);
+        ~TransactionEngine();
+        TransactionEngine(const TransactionEngine&) = delete;
+        TransactionEngine& operator=(const TransactionEngine&) = delete;
+
+        // Queue a request; `request` is copied. Requests sharing a key are serialised.
+        // Thread-safe; wakes a pump() asleep in the driver (cancelIo) if the window has room.
+        // The callback runs on the thread calling pump().
+        std::future<Result> submit(Key key, std::span<const uint8_t> request);
+        std::future<Result> submit(Key key, std::span<const uint8_t> request, const Limits &limits);
+        void submit(Key key, std::span<const uint8_t> request, const Limits &limits, Callback onDone);
+
+        // send, receive and expire until nothing is outstanding or `timeout` (<0 == forever)
+        // runs out; returns transactions completed. Call from one thread.
+        std::size_t pump(std::chrono::milliseconds timeout);
+
+        // complete everything queued or in flight as cancelled (pump thread, or when idle)
+        void cancelAll();
+
+        [[nodiscard]] std::size_t pending() const;
+        [[nodiscard]] uint64_t unmatchedFrames() const { return m_Unmatched.load(std::memory_order_relaxed); }
+
+    private:
+        struct Transaction
+        {
+            Key                  key;
+            std::vector<uint8_t> request;
+            Limits               limits;
+            Callback             onDone;
+            Clock::time_point    submitted {};
+            Clock::time_point    firstSent {};
+            Clock::time_point    deadline {};
+            uint32_t             attempts {0};
+        };
+
+        void launch_(Clock::time_point now);
+        bool send_(Transaction &txn, Clock::time_point now);
+        std::size_t expire_(Clock::time_point now);
+        std::size_t receive_(std::chrono::milliseconds wait);
+        static void complete_(Transaction &txn, Status status, std::vector<uint8_t> response, Clock::time_point now);
+
+    private:
+        ISerialDriver               &m_Driver;
+        Framer                       m_Framer;
+        KeyOf                        m_KeyOf;
+        Options                      m_Options;
+
+        mutable std::mutex           m_Mutex;      // guards m_Queue
+        std::deque<Transaction>      m_Queue;
+        std::atomic<uint64_t>        m_Submitted {0};
+        std::atomic<bool>            m_PumpWaiting {false};  // pump is (about to be) in readSome
+
+        std::vector<Transaction>     m_InFlight;   // pump thread only; small, scanned linearly
+        std::atomic<std::size_t>     m_InFlightCount {0};
+        std::vector<uint8_t>         m_Rx;         // received, not yet framed
+        std::atomic<uint64_t>        m_Unmatched {0};
+    };
+}
+
+#endif //COMLIBPP_TRANSACTIONENGINE_HPP
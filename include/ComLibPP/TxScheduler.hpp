@@ -0,0 +1,87 @@
+#ifndef COMLIBPP_TXSCHEDULER_HPP
+#define COMLIBPP_TXSCHEDULER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "ISerialDriver.hpp"
+#include "export.hpp"
+
+namespace ucpgr
+{
+    // Priority write front end over a driver. Messages are queued whole; at every
+    // message boundary the scheduler picks the oldest high-priority message first,
+    // so an alarm waits for at most the message on the wire plus the paced driver queue.
+    // Queues are fixed rings sized up front: O(1) per message, no steady-state allocation.
+    class COMLIBPP_API TxScheduler
+    {
+    public:
+        enum class Priority : uint8_t { high, low };
+
+        struct Options
+        {
+            std::size_t queueBytes {16 * 1024};          // per priority
+            std::size_t maxMessages {256};               // per priority
+            std::chrono::milliseconds lowMaxAge {1000};  // stale low-priority messages are dropped (0 == never)
+            std::chrono::microseconds pacing {2000};     // line time allowed in the driver queue
+        };
+
+        explicit TxScheduler(ISerialDriver &driver);
+        TxScheduler(ISerialDriver &driver, const Options &options);
+        TxScheduler(const TxScheduler&) = delete;
+        TxScheduler& operator=(const TxScheduler&) = delete;
+
+        // queue a whole message; false (nothing queued) when its queue is full. Thread-safe.
+        bool submit(Priority priority, std::span<const uint8_t> message);
+
+        // hand bytes to the driver until the queues are empty or `timeout` runs out;
+        // returns bytes written. Call from one thread.
+        std::size_t pump(std::chrono::milliseconds timeout);
+
+        [[nodiscard]] std::size_t pendingMessages(Priority priority) const;
+        [[nodiscard]] uint64_t droppedMessages() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Message
+        {
+            uint64_t          begin;   // position in the lane's byte stream
+            std::size_t       size;
+            Clock::time_point enqueued;
+        };
+
+        struct Lane
+        {
+            std::vector<uint8_t> bytes;
+            std::vector<Message> messages;
+            uint64_t             byteHead {0};
+            uint64_t             byteTail {0};
+            std::size_t          msgHead {0};
+            std::size_t          msgTail {0};
+
+            [[nodiscard]] bool empty() const { return msgHead == msgTail; }
+            [[nodiscard]] const Message& front() const { return messages[msgHead % messages.size()]; }
+            void pop();
+        };
+
+        // next message to put on the wire (caller holds the lock); nullptr when idle
+        Lane* select_(Clock::time_point now);
+        [[nodiscard]] std::size_t room_() const;
+
+    private:
+        ISerialDriver          &m_Driver;
+        Options                 m_Options;
+        mutable std::mutex      m_Mutex;
+        std::array<Lane, 2>     m_Lanes;
+        Lane                   *m_Current {nullptr};  // message being sent; finished before switching
+        std::size_t             m_CurrentSent {0};
+        uint64_t                m_Dropped {0};
+    };
+}
+
+#endif //COMLIBPP_TXSCHEDULER_HPP
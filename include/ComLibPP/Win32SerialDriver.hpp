@@ -164,47 +164,13 @@ public:
     std::size_t readSome(uint8_t* dst, std::size_t maxBytes,
                          std::chrono::milliseconds timeout) override
     {
-        if (!isOpen())
-        {
-            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "readSome on closed port");
-        }
-
-        OVERLAPPED ov{};
-        ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
-        if (!ov.hEvent)
-        {
-            throwLastError_("CreateEventW");
-        }
-
-        DWORD got = 0;
-        BOOL ok = ReadFile(m_Handle, dst, static_cast<DWORD>(maxBytes), &got, &ov);
-        if (!ok && GetLastError() == ERROR_IO_PENDING)
-        {
-            const DWORD waitMs = toWaitMs_(timeout);
-            if (const DWORD r = WaitForSingleObject(ov.hEvent, waitMs); r == WAIT_OBJECT_0)
-            {
-                if (!GetOverlappedResult(m_Handle, &ov, &got, FALSE))
-                {
-                    got = 0;
-                }
-            }
-            else if (r == WAIT_TIMEOUT)
-            {
-                CancelIoEx(m_Handle, &ov);
-                got = 0;
-            }
-            else
-            {
-                got = 0;
-            }
-        }
-        else if (!ok)
-        {
-            got = 0;
-        }
+        return read_(dst, maxBytes, timeout, nullptr);
+    }
 
-        CloseHandle(ov.hEvent);
-        return static_cast<std::size_t>(got);
+    std::size_t readSomeTimestamped(uint8_t* dst, std::size_t maxBytes,
+                                    std::chrono::milliseconds timeout, RxTimestamp &stamp) override
+    {
+        return read_(dst, maxBytes, timeout, &stamp);
     }
 
     std::size_t writeSome(const uint8_t* src, std::size_t n,
@@ -268,6 +234,21 @@ public:
         return static_cast<std::size_t>(st.cbInQue);
     }
 
+    [[nodiscard]] std::size_t bytesPending() const override
+    {
+        if (!isOpen())
+        {
+            return 0;
+        }
+        COMSTAT st{};
+        DWORD errs{};
+        if (!ClearCommError(m_Handle, &errs, &st))
+        {
+            return 0;
+        }
+        return static_cast<std::size_t>(st.cbOutQue);
+    }
+
     void cancelIo() override
     {
         if (isOpen())
@@ -277,6 +258,60 @@ public:
     }
 
 private:
+    std::size_t read_(uint8_t* dst, std::size_t maxBytes,
+                      std::chrono::milliseconds timeout, RxTimestamp *stamp)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "readSome on closed port");
+        }
+
+        OVERLAPPED ov{};
+        ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!ov.hEvent)
+        {
+            throwLastError_("CreateEventW");
+        }
+
+        DWORD got = 0;
+        BOOL ok = ReadFile(m_Handle, dst, static_cast<DWORD>(maxBytes), &got, &ov);
+        if (stamp && ok)
+        {
+            *stamp = RxTimestamp::now();
+        }
+        if (!ok && GetLastError() == ERROR_IO_PENDING)
+        {
+            const DWORD waitMs = toWaitMs_(timeout);
+            if (const DWORD r = WaitForSingleObject(ov.hEvent, waitMs); r == WAIT_OBJECT_0)
+            {
+                if (stamp)
+                {
+                    *stamp = RxTimestamp::now(); // completion event, before any bookkeeping
+                }
+                if (!GetOverlappedResult(m_Handle, &ov, &got, FALSE))
+                {
+                    got = 0;
+                }
+            }
+            else if (r == WAIT_TIMEOUT)
+            {
+                CancelIoEx(m_Handle, &ov);
+                got = 0;
+            }
+            else
+            {
+                got = 0;
+            }
+        }
+        else if (!ok)
+        {
+            got = 0;
+        }
+
+        CloseHandle(ov.hEvent);
+        return static_cast<std::size_t>(got);
+    }
+
     static uint8_t toWinParity_(const Parity p)
     {
         switch (p)
@@ -0,0 +1,214 @@
+#include <limits>
+#include <utility>
+#include <ComLibPP/BroadcastReader.hpp>
+
+namespace ucpgr
+{
+    static constexpr uint64_t kInvalidSequence = std::numeric_limits<uint64_t>::max();
+
+    // Slabs are never freed while the reader lives, so a subscriber may race a
+    // recycle safely: it only keeps a slab whose refcount it raised from non-zero
+    // and whose sequence still matches afterwards.
+    struct BroadcastReader::Slab
+    {
+        explicit Slab(std::size_t capacity) : bytes(new uint8_t[capacity]) {}
+
+        std::atomic<uint32_t>      refs {0};
+        std::atomic<uint64_t>      sequence {kInvalidSequence};
+        std::size_t                size {0};
+        ISerialDriver::RxTimestamp stamp {};
+        std::unique_ptr<uint8_t[]> bytes;
+    };
+
+    // ------------------------------
+    // Chunk
+    // ------------------------------
+
+    BroadcastReader::Chunk::~Chunk()
+    {
+        if (m_Slab)
+            release_(m_Slab);
+    }
+
+    BroadcastReader::Chunk::Chunk(Chunk &&other) noexcept
+        : m_Slab(std::exchange(other.m_Slab, nullptr)), m_Sequence(other.m_Sequence)
+    {
+    }
+
+    BroadcastReader::Chunk &BroadcastReader::Chunk::operator=(Chunk &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_Slab)
+                release_(m_Slab);
+            m_Slab = std::exchange(other.m_Slab, nullptr);
+            m_Sequence = other.m_Sequence;
+        }
+        return *this;
+    }
+
+    std::span<const uint8_t> BroadcastReader::Chunk::data() const
+    {
+        if (!m_Slab)
+            return {};
+        return {m_Slab->bytes.get(), m_Slab->size};
+    }
+
+    ISerialDriver::RxTimestamp BroadcastReader::Chunk::timestamp() const
+    {
+        if (!m_Slab)
+            return {};
+        return m_Slab->stamp;
+    }
+
+    // ------------------------------
+    // Subscription
+    // ------------------------------
+
+    std::optional<BroadcastReader::Chunk> BroadcastReader::Subscription::poll()
+    {
+        const std::size_t slots = m_Reader->m_Options.ringSlots;
+
+        while (!m_Dropped)
+        {
+            const uint64_t head = m_Reader->m_Head.load(std::memory_order_acquire);
+            if (m_Cursor == head)
+                return std::nullopt;
+
+            if (head - m_Cursor <= slots)
+            {
+                Slab *slab = m_Reader->m_Ring[m_Cursor % slots].load(std::memory_order_acquire);
+                if (slab && retain_(slab))
+                {
+                    if (slab->sequence.load(std::memory_order_acquire) == m_Cursor)
+                        return Chunk{slab, m_Cursor++};
+                    release_(slab);
+                }
+            }
+
+            // the pump lapped us
+            if (m_Reader->m_Options.policy == SlowConsumerPolicy::drop)
+            {
+                m_Dropped = true;
+                break;
+            }
+
+            const uint64_t latest = m_Reader->m_Head.load(std::memory_order_acquire);
+            const uint64_t oldest = latest > slots ? latest - slots : 0;
+            if (oldest > m_Cursor)
+            {
+                m_Lost += oldest - m_Cursor;
+                m_Cursor = oldest;
+            }
+            else
+            {
+                // slot was recycled between our head read and the lookup
+                m_Lost += 1;
+                m_Cursor += 1;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::size_t BroadcastReader::Subscription::pending() const
+    {
+        if (m_Dropped)
+            return 0;
+        return static_cast<std::size_t>(m_Reader->m_Head.load(std::memory_order_acquire) - m_Cursor);
+    }
+
+    // ------------------------------
+    // BroadcastReader
+    // ------------------------------
+
+    BroadcastReader::BroadcastReader(ISerialDriver &driver) : BroadcastReader(driver, Options{})
+    {
+    }
+
+    BroadcastReader::BroadcastReader(ISerialDriver &driver, const Options &options)
+        : m_Driver(driver), m_Options(options),
+          m_Ring(new std::atomic<Slab*>[options.ringSlots == 0 ? 1 : options.ringSlots])
+    {
+        if (m_Options.ringSlots == 0)
+            m_Options.ringSlots = 1;
+
+        for (std::size_t i = 0; i < m_Options.ringSlots; ++i)
+            m_Ring[i].store(nullptr, std::memory_order_relaxed);
+
+        // ring + headroom for chunks held by subscribers; grows on demand
+        m_Pool.reserve(m_Options.ringSlots * 2);
+        for (std::size_t i = 0; i < m_Options.ringSlots + 1; ++i)
+            m_Pool.push_back(std::make_unique<Slab>(m_Options.slabSize));
+        m_SlabCount.store(m_Pool.size(), std::memory_order_relaxed);
+    }
+
+    BroadcastReader::~BroadcastReader() = default;
+
+    BroadcastReader::Subscription BroadcastReader::subscribe() const
+    {
+        return Subscription{*this, m_Head.load(std::memory_order_acquire)};
+    }
+
+    std::size_t BroadcastReader::pump(std::chrono::milliseconds timeout)
+    {
+        Slab *slab = acquireSlab_();
+
+        const std::size_t got = m_Driver.readSomeTimestamped(slab->bytes.get(), m_Options.slabSize, timeout, slab->stamp);
+        if (got == 0)
+        {
+            release_(slab);
+            return 0;
+        }
+
+        const uint64_t seq = m_Head.load(std::memory_order_relaxed);
+        slab->size = got;
+        slab->sequence.store(seq, std::memory_order_release);
+
+        // the acquisition reference becomes the ring's reference
+        if (Slab *old = m_Ring[seq % m_Options.ringSlots].exchange(slab, std::memory_order_acq_rel))
+        {
+            old->sequence.store(kInvalidSequence, std::memory_order_release);
+            release_(old);
+        }
+
+        m_Head.store(seq + 1, std::memory_order_release);
+        return got;
+    }
+
+    BroadcastReader::Slab *BroadcastReader::acquireSlab_()
+    {
+        const std::size_t n = m_Pool.size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            Slab *slab = m_Pool[(m_NextScan + i) % n].get();
+            uint32_t expected = 0;
+            if (slab->refs.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+            {
+                m_NextScan = (m_NextScan + i + 1) % n;
+                return slab;
+            }
+        }
+
+        // every slab is pinned by the ring or a subscriber: grow rather than stall the port
+        auto &slab = m_Pool.emplace_back(std::make_unique<Slab>(m_Options.slabSize));
+        slab->refs.store(1, std::memory_order_relaxed);
+        m_SlabCount.store(m_Pool.size(), std::memory_order_relaxed);
+        return slab.get();
+    }
+
+    bool BroadcastReader::retain_(Slab *slab)
+    {
+        uint32_t refs = slab->refs.load(std::memory_order_relaxed);
+        while (refs != 0)
+        {
+            if (slab->refs.compare_exchange_weak(refs, refs + 1, std::memory_order_acquire))
+                return true;
+        }
+        return false;
+    }
+
+    void BroadcastReader::release_(Slab *slab)
+    {
+        slab->refs.fetch_sub(1, std::memory_order_release);
+    }
+}
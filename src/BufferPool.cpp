@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <ComLibPP/BufferPool.hpp>
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace ucpgr
+{
+    static constexpr std::align_val_t kBlockAlign {64};
+
+    BufferPool::BufferPool() : BufferPool(Options{})
+    {
+    }
+
+    BufferPool::BufferPool(const Options &options) : m_Options(options)
+    {
+        m_Options.minBlock = std::bit_ceil(std::max<std::size_t>(m_Options.minBlock, 64));
+        m_Options.maxBlock = std::bit_ceil(std::max(m_Options.maxBlock, m_Options.minBlock));
+        m_Classes = static_cast<std::size_t>(std::countr_zero(m_Options.maxBlock) - std::countr_zero(m_Options.minBlock)) + 1;
+
+        for (auto &shard : m_Shards)
+            shard.free.resize(m_Classes);
+    }
+
+    BufferPool::~BufferPool()
+    {
+        trim();
+    }
+
+    BufferPool::Block BufferPool::borrow(std::size_t size)
+    {
+        const std::size_t cls = classOf_(size);
+        const uint32_t node = currentNode_();
+
+        if (cls == kOversize)
+        {
+            m_Outstanding.fetch_add(1, std::memory_order_relaxed);
+            return {allocate_(size), size, node};
+        }
+
+        const std::size_t blockSize = classSize_(cls);
+        {
+            Shard &shard = m_Shards[node % kShards];
+            std::lock_guard lock(shard.mutex);
+            auto &list = shard.free[cls];
+            if (!list.empty())
+            {
+                uint8_t* p = list.back();
+                list.pop_back();
+                m_Cached.fetch_sub(1, std::memory_order_relaxed);
+                m_Outstanding.fetch_add(1, std::memory_order_relaxed);
+                return {p, blockSize, node};
+            }
+        }
+
+        // fresh memory is first touched by the borrowing thread, so it lands on this node
+        m_Outstanding.fetch_add(1, std::memory_order_relaxed);
+        return {allocate_(blockSize), blockSize, node};
+    }
+
+    void BufferPool::giveBack(Block block)
+    {
+        if (!block)
+            return;
+
+        m_Outstanding.fetch_sub(1, std::memory_order_relaxed);
+
+        const std::size_t cls = classOf_(block.size);
+        if (cls != kOversize && classSize_(cls) == block.size)
+        {
+            Shard &shard = m_Shards[block.node % kShards];
+            std::lock_guard lock(shard.mutex);
+            auto &list = shard.free[cls];
+            if (list.size() < m_Options.maxCachedPerClass)
+            {
+                list.push_back(block.data);
+                m_Cached.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        deallocate_(block.data);
+    }
+
+    void BufferPool::trim()
+    {
+        for (auto &shard : m_Shards)
+        {
+            std::lock_guard lock(shard.mutex);
+            for (auto &list : shard.free)
+            {
+                for (uint8_t* p : list)
+                    deallocate_(p);
+                m_Cached.fetch_sub(list.size(), std::memory_order_relaxed);
+                list.clear();
+                list.shrink_to_fit();
+            }
+        }
+    }
+
+    std::size_t BufferPool::classOf_(std::size_t size) const
+    {
+        if (size > m_Options.maxBlock)
+            return kOversize;
+        const std::size_t rounded = std::bit_ceil(std::max(size, m_Options.minBlock));
+        return static_cast<std::size_t>(std::countr_zero(rounded) - std::countr_zero(m_Options.minBlock));
+    }
+
+    std::size_t BufferPool::classSize_(std::size_t cls) const
+    {
+        return m_Options.minBlock << cls;
+    }
+
+    uint32_t BufferPool::currentNode_()
+    {
+#if defined(__linux__)
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if (getcpu(&cpu, &node) == 0)
+            return node;
+#elif defined(_WIN32)
+        PROCESSOR_NUMBER pn{};
+        GetCurrentProcessorNumberEx(&pn);
+        USHORT node = 0;
+        if (GetNumaProcessorNodeEx(&pn, &node))
+            return node;
+#endif
+        return 0;
+    }
+
+    uint8_t* BufferPool::allocate_(std::size_t size)
+    {
+        return static_cast<uint8_t*>(::operator new(size, kBlockAlign));
+    }
+
+    void BufferPool::deallocate_(uint8_t* p)
+    {
+        ::operator delete(p, kBlockAlign);
+    }
+}
@@ -1,10 +1,15 @@
+#include <algorithm>
+#include <bit>
 #include <cstring>
+#include <thread>
+#include <utility>
 #include <ComLibPP/ComLibPP.hpp>
 
 ucpgr::SerialStreamBuf::SerialStreamBuf(ISerialDriver &driver)
         : m_Driver{driver},
-          m_InBuf(4096),
-          m_OutBuf(4096)
+          m_BufferSize{bufferSizeFor_(driver.getSerialSettings())},
+          m_InBuf(m_BufferSize),
+          m_OutBuf(m_BufferSize)
 {
     // empty get area
     setg(reinterpret_cast<char*>(m_InBuf.data()),
@@ -27,6 +32,12 @@ ucpgr::SerialStreamBuf::~SerialStreamBuf()
     {
         // ignore all exceptions in destructor
     }
+
+    if (m_Pool)
+    {
+        m_Pool->giveBack(m_InBlock);
+        m_Pool->giveBack(m_OutBlock);
+    }
 }
 
 ucpgr::SerialStreamBuf::int_type ucpgr::SerialStreamBuf::underflow()
@@ -37,21 +48,252 @@ ucpgr::SerialStreamBuf::int_type ucpgr::SerialStreamBuf::underflow()
     }
 
     // choose timeout per policy
-    auto tmo = timeoutForRead_();
-
-    std::size_t got = m_Driver.readSome(m_InBuf.data(), m_InBuf.size(), tmo);
-    if (got == 0)
+    if (!refill_(timeoutForRead_()))
     {
         // timeout / no data (not a fatal EOF)
         return traits_type::eof();
     }
-
-    setg(reinterpret_cast<char*>(m_InBuf.data()),
-         reinterpret_cast<char*>(m_InBuf.data()),
-         reinterpret_cast<char*>(m_InBuf.data() + got));
     return traits_type::to_int_type(*gptr());
 }
 
+std::size_t ucpgr::SerialStreamBuf::bufferSizeFor_(const ISerialDriver::SerialSettings &settings)
+{
+    // ~10 ms of line time per refill/flush, so multi-Mbaud links are not syscall-bound
+    const std::size_t perTenMs = settings.baud / settings.bitsPerChar() / 100;
+    return std::bit_ceil(std::clamp(perTenMs, kBufferSize, kMaxBufferSize));
+}
+
+bool ucpgr::SerialStreamBuf::refill_(std::chrono::milliseconds tmo)
+{
+    uint8_t *dst = m_InBuf.data();
+    std::size_t cap = m_InBuf.size();
+    if (m_Pool)
+    {
+        // a port that was quiet polls into the probe; a block is only borrowed once it talks
+        if (!m_InBlock && std::chrono::steady_clock::now() - m_LastRx < m_IdleRelease)
+        {
+            m_InBlock = m_Pool->borrow(m_BufferSize);
+        }
+        dst = m_InBlock ? m_InBlock.data : m_Probe.data();
+        cap = m_InBlock ? m_InBlock.size : m_Probe.size();
+    }
+
+    std::size_t got;
+    if (m_RxTimestamps)
+    {
+        ISerialDriver::RxTimestamp stamp;
+        got = m_Driver.readSomeTimestamped(dst, cap, tmo, stamp);
+        if (got != 0)
+        {
+            m_RxStamps[m_RxStampCount++ % kRxStampSlots] = {m_RxTotal, stamp};
+        }
+    }
+    else
+    {
+        got = m_Driver.readSome(dst, cap, tmo);
+    }
+
+    if (got == 0)
+    {
+        if (m_Pool)
+        {
+            releaseIdle_(std::chrono::steady_clock::now());
+        }
+        return false;
+    }
+    m_RxTotal += got;
+    if (m_Pool)
+    {
+        m_LastRx = std::chrono::steady_clock::now();
+    }
+
+    setg(reinterpret_cast<char*>(dst),
+         reinterpret_cast<char*>(dst),
+         reinterpret_cast<char*>(dst + got));
+    return true;
+}
+
+ucpgr::SerialStreamBuf::WaitResult ucpgr::SerialStreamBuf::waitFor(std::span<const std::string_view> patterns,
+                                                                  std::chrono::steady_clock::time_point deadline)
+{
+    const PatternMatcher matcher{patterns};
+    return waitFor(matcher, deadline);
+}
+
+ucpgr::SerialStreamBuf::WaitResult ucpgr::SerialStreamBuf::waitFor(const PatternMatcher &matcher,
+                                                                  std::chrono::steady_clock::time_point deadline)
+{
+    m_WaitSpill.clear();
+    bool spilled = false;
+    PatternMatcher::State state = PatternMatcher::kStart;
+
+    for (;;)
+    {
+        char *start = gptr();
+        for (char *p = start; p < egptr(); ++p)
+        {
+            state = matcher.step(state, static_cast<uint8_t>(*p));
+            const int pattern = matcher.match(state);
+            if (pattern < 0)
+            {
+                continue;
+            }
+
+            // consume through the match; `before` stays in the get area unless we refilled
+            char *end = p + 1;
+            const std::size_t length = matcher.patternLength(pattern);
+            setg(eback(), end, egptr());
+            if (!spilled)
+            {
+                return {pattern, std::string_view(start, static_cast<std::size_t>(end - start) - length)};
+            }
+            m_WaitSpill.append(start, end);
+            return {pattern, std::string_view(m_WaitSpill).substr(0, m_WaitSpill.size() - length)};
+        }
+
+        // keep what we scanned; the refill overwrites the get area
+        m_WaitSpill.append(start, egptr());
+        spilled = true;
+        setg(eback(), egptr(), egptr());
+
+        const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0 || (!refill_(left) && std::chrono::steady_clock::now() >= deadline))
+        {
+            // a match still in progress stays unread, so a retry can complete it
+            const std::size_t partial = matcher.depth(state);
+            if (partial > 0)
+            {
+                m_WaitCarry.assign(m_WaitSpill, m_WaitSpill.size() - partial, partial);
+                setg(m_WaitCarry.data(), m_WaitCarry.data(), m_WaitCarry.data() + partial);
+            }
+            return {-1, std::string_view(m_WaitSpill).substr(0, m_WaitSpill.size() - partial)};
+        }
+    }
+}
+
+void ucpgr::SerialStreamBuf::usePool(BufferPool &pool, std::chrono::milliseconds idleRelease)
+{
+    m_IdleRelease = idleRelease;
+    if (m_Pool)
+    {
+        return;
+    }
+
+    (void)flushOut_();
+    m_Pool = &pool;
+
+    // carry over whatever is still buffered, then drop the eager vectors
+    if (const auto unread = static_cast<std::size_t>(egptr() - gptr()); unread > 0)
+    {
+        m_InBlock = m_Pool->borrow(std::max(m_BufferSize, unread));
+        std::memcpy(m_InBlock.data, gptr(), unread);
+        setg(reinterpret_cast<char*>(m_InBlock.data),
+             reinterpret_cast<char*>(m_InBlock.data),
+             reinterpret_cast<char*>(m_InBlock.data + unread));
+    }
+    else
+    {
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    if (const auto pending = static_cast<std::size_t>(pptr() - pbase()); pending > 0)
+    {
+        m_OutBlock = m_Pool->borrow(m_BufferSize);
+        std::memcpy(m_OutBlock.data, pbase(), pending);
+        setp(reinterpret_cast<char*>(m_OutBlock.data),
+             reinterpret_cast<char*>(m_OutBlock.data + m_OutBlock.size));
+        pbump(static_cast<int>(pending));
+    }
+    else
+    {
+        setp(nullptr, nullptr);
+    }
+
+    std::vector<uint8_t>().swap(m_InBuf);
+    std::vector<uint8_t>().swap(m_OutBuf);
+    m_LastRx = m_LastTx = std::chrono::steady_clock::now() - idleRelease;
+}
+
+void ucpgr::SerialStreamBuf::releaseIdle()
+{
+    if (m_Pool)
+    {
+        releaseIdle_(std::chrono::steady_clock::now());
+    }
+}
+
+bool ucpgr::SerialStreamBuf::holdsBuffers() const
+{
+    if (m_Pool)
+    {
+        return m_InBlock || m_OutBlock;
+    }
+    return !m_InBuf.empty() || !m_OutBuf.empty();
+}
+
+void ucpgr::SerialStreamBuf::releaseIdle_(std::chrono::steady_clock::time_point now)
+{
+    if (m_InBlock && gptr() == egptr() && now - m_LastRx >= m_IdleRelease)
+    {
+        m_Pool->giveBack(std::exchange(m_InBlock, {}));
+        setg(nullptr, nullptr, nullptr);
+    }
+    if (m_OutBlock && pptr() == pbase() && now - m_LastTx >= m_IdleRelease)
+    {
+        m_Pool->giveBack(std::exchange(m_OutBlock, {}));
+        setp(nullptr, nullptr);
+    }
+}
+
+bool ucpgr::SerialStreamBuf::ensurePutArea_()
+{
+    if (pbase() != nullptr)
+    {
+        return true;
+    }
+    if (!m_Pool)
+    {
+        return false;
+    }
+
+    m_OutBlock = m_Pool->borrow(m_BufferSize);
+    m_LastTx = std::chrono::steady_clock::now();
+    setp(reinterpret_cast<char*>(m_OutBlock.data),
+         reinterpret_cast<char*>(m_OutBlock.data + m_OutBlock.size));
+    return true;
+}
+
+void ucpgr::SerialStreamBuf::enableRxTimestamps(bool enable)
+{
+    m_RxTimestamps = enable;
+    m_RxStampCount = 0;
+}
+
+uint64_t ucpgr::SerialStreamBuf::rxPosition() const
+{
+    return m_RxTotal - static_cast<uint64_t>(egptr() - gptr());
+}
+
+std::optional<ucpgr::ISerialDriver::RxTimestamp> ucpgr::SerialStreamBuf::rxTimestampAt(uint64_t position) const
+{
+    if (position >= m_RxTotal)
+    {
+        return std::nullopt;
+    }
+
+    // newest first: the first chunk starting at or before `position` holds it
+    const std::size_t live = std::min(m_RxStampCount, kRxStampSlots);
+    for (std::size_t i = 1; i <= live; ++i)
+    {
+        const RxStamp &entry = m_RxStamps[(m_RxStampCount - i) % kRxStampSlots];
+        if (entry.position <= position)
+        {
+            return entry.stamp;
+        }
+    }
+    return std::nullopt;
+}
+
 // flush put area
 int ucpgr::SerialStreamBuf::sync()
 {
@@ -60,23 +302,53 @@ int ucpgr::SerialStreamBuf::sync()
 
 std::streambuf::int_type ucpgr::SerialStreamBuf::overflow(int_type ch)
 {
+    if (!ensurePutArea_())
+    {
+        return traits_type::eof();
+    }
+
     if (!traits_type::eq_int_type(ch, traits_type::eof()))
     {
+        if (pptr() == epptr() && !flushOut_(false))
+        {
+            return traits_type::eof();
+        }
         *pptr() = traits_type::to_char_type(ch);
         pbump(1);
     }
-    return flushOut_() ? traits_type::not_eof(ch) : traits_type::eof();
+    return flushOut_(false) ? traits_type::not_eof(ch) : traits_type::eof();
+}
+
+bool ucpgr::SerialStreamBuf::putSlow_(char c)
+{
+    // put area full (or not yet borrowed): make room, then store
+    if (!ensurePutArea_())
+    {
+        return false;
+    }
+    if (pptr() == epptr() && !flushOut_(false))
+    {
+        return false;
+    }
+    *pptr() = c;
+    pbump(1);
+    return true;
 }
 
 std::streamsize ucpgr::SerialStreamBuf::xsputn(const char* s, std::streamsize n)
 {
+    if (!ensurePutArea_())
+    {
+        return 0;
+    }
+
     std::streamsize total = 0;
     while (n > 0)
     {
         auto room = epptr() - pptr();
         if (room == 0)
         {
-            if (!flushOut_())
+            if (!flushOut_(false))
             {
                 break;
             }
@@ -92,7 +364,7 @@ std::streamsize ucpgr::SerialStreamBuf::xsputn(const char* s, std::streamsize n)
 
         if ((epptr() - pptr()) < 64)
         {
-            if (!flushOut_())
+            if (!flushOut_(false))
             {
                 break;
             }
@@ -138,7 +410,7 @@ std::streambuf::pos_type ucpgr::SerialStreamBuf::seekpos(pos_type, std::ios_base
 }
 
 
-bool ucpgr::SerialStreamBuf::flushOut_()
+bool ucpgr::SerialStreamBuf::flushOut_(bool drainAll)
 {
     auto n = static_cast<std::size_t>(pptr() - pbase());
     if (n == 0)
@@ -146,37 +418,121 @@ bool ucpgr::SerialStreamBuf::flushOut_()
         return true;
     }
 
+    const std::size_t written = writeOut_(reinterpret_cast<const uint8_t *>(pbase()), n, drainAll);
+
+    // shift remaining (if any) to beginning
+    const auto remaining = n - written;
+    if (remaining > 0)
+    {
+        std::memmove(pbase(),
+                     reinterpret_cast<const uint8_t *>(pbase()) + written,
+                     remaining);
+    }
+
+    setp(pbase(), epptr());
+    pbump(static_cast<int>(remaining));
+    return written > 0 || remaining == 0;
+}
+
+std::size_t ucpgr::SerialStreamBuf::writeOut_(const uint8_t *data, std::size_t n, bool drainAll)
+{
     auto tmo = timeoutForWrite_();
+    const auto deadline = std::chrono::steady_clock::now() + std::max(tmo, std::chrono::milliseconds{0});
 
     std::size_t written = 0;
     while (written < n)
     {
-        std::size_t w = m_Driver.writeSome(
-            reinterpret_cast<const uint8_t *>(pbase()) + written,
-            n - written,
-            tmo);
+        std::size_t chunk = n - written;
+        if (m_TxPacing.count() > 0)
+        {
+            const std::size_t room = txRoom_();
+            if (room == 0)
+            {
+                // making room is enough for overflow/xsputn; only sync drains everything
+                if ((!drainAll && written > 0) || !waitTxRoom_(deadline, tmo))
+                {
+                    break;
+                }
+                continue;
+            }
+            chunk = std::min(chunk, room);
+        }
+
+        std::size_t w = m_Driver.writeSome(data + written, chunk, tmo);
 
         if (w == 0)
         {
-            // timed out (non-fatal) — leave remaining bytes in buffer
-            // You can choose to treat this as failure if you prefer.
+            // timed out (non-fatal) — the caller keeps the remaining bytes
             break;
         }
         written += w;
     }
+    if (m_Pool && written > 0)
+    {
+        m_LastTx = std::chrono::steady_clock::now();
+    }
+    return written;
+}
 
-    // shift remaining (if any) to beginning
-    const auto remaining = n - written;
-    if (remaining > 0)
+std::size_t ucpgr::SerialStreamBuf::writeThrough(std::span<const uint8_t> data)
+{
+    // anything left in the put area has to go first
+    if (!flushOut_() || pptr() != pbase())
     {
-        std::memmove(pbase(),
-                     reinterpret_cast<const uint8_t *>(pbase()) + written,
-                     remaining);
+        return 0;
     }
+    return writeOut_(data.data(), data.size(), true);
+}
+
+void ucpgr::SerialStreamBuf::setTxPacing(std::chrono::microseconds targetDrain)
+{
+    m_TxPacing = targetDrain;
+}
+
+std::size_t ucpgr::SerialStreamBuf::txBacklog() const
+{
+    return static_cast<std::size_t>(pptr() - pbase());
+}
 
+std::size_t ucpgr::SerialStreamBuf::discardOutput()
+{
+    const std::size_t dropped = txBacklog();
     setp(pbase(), epptr());
-    pbump(static_cast<int>(remaining));
-    return written > 0 || remaining == 0;
+    return dropped;
+}
+
+std::size_t ucpgr::SerialStreamBuf::txRoom_() const
+{
+    const std::size_t cap = m_Driver.getSerialSettings().bytesFor(m_TxPacing);
+
+    const std::size_t queued = m_Driver.bytesPending();
+    return queued < cap ? cap - queued : 0;
+}
+
+bool ucpgr::SerialStreamBuf::waitTxRoom_(std::chrono::steady_clock::time_point deadline, std::chrono::milliseconds tmo) const
+{
+    if (tmo.count() == 0)
+    {
+        return false;
+    }
+
+    // sleep until the queue is about half way below target, not for every byte
+    const auto &settings = m_Driver.getSerialSettings();
+    const auto charTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double>(
+        static_cast<double>(settings.bitsPerChar()) / std::max<uint32_t>(settings.baud, 1)));
+    auto wait = std::max(m_TxPacing / 2, charTime);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (tmo.count() > 0)
+    {
+        if (now >= deadline)
+        {
+            return false;
+        }
+        wait = std::min(wait, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now));
+    }
+    std::this_thread::sleep_for(wait);
+    return true;
 }
 
 [[nodiscard]] std::chrono::milliseconds ucpgr::SerialStreamBuf::timeoutForRead_() const
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <ComLibPP/FleetIo.hpp>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <poll.h>
+#endif
+
+namespace ucpgr
+{
+    // how long a pass may sleep while descriptor-less drivers are still pending
+    static constexpr std::chrono::milliseconds kFallbackSlice {1};
+
+    struct FleetIo::Scratch
+    {
+#ifndef _WIN32
+        std::vector<pollfd>      fds;
+#endif
+        std::vector<std::size_t> polled;    // op index per fds entry
+        std::vector<std::size_t> unpolled;  // ops whose driver has no descriptor
+    };
+
+    FleetIo::FleetIo() : m_Scratch(std::make_unique<Scratch>())
+    {
+    }
+
+    FleetIo::~FleetIo() = default;
+
+    std::size_t FleetIo::step(std::span<Operation> ops, std::chrono::milliseconds maxWait, const Completion &onComplete)
+    {
+        std::size_t finished = 0;
+        auto complete = [&](Operation &op, Status status) {
+            op.status = status;
+            ++finished;
+            if (onComplete)
+                onComplete(op);
+        };
+        auto attempt = [&](Operation &op) {
+            try
+            {
+                if (transfer_(op))
+                    complete(op, Status::done);
+            }
+            catch (const std::system_error &e)
+            {
+                op.error = e.code();
+                complete(op, Status::failed);
+            }
+        };
+
+        Scratch &s = *m_Scratch;
+#ifndef _WIN32
+        s.fds.clear();
+#endif
+        s.polled.clear();
+        s.unpolled.clear();
+
+        auto now = Clock::now();
+        auto wakeAt = now + maxWait;
+        for (std::size_t i = 0; i < ops.size(); ++i)
+        {
+            Operation &op = ops[i];
+            if (op.status != Status::pending)
+                continue;
+            if (now >= op.deadline)
+            {
+                complete(op, Status::timedOut);
+                continue;
+            }
+            wakeAt = std::min(wakeAt, op.deadline);
+
+#ifndef _WIN32
+            if (const int fd = op.driver->pollDescriptor(); fd >= 0)
+            {
+                s.fds.push_back({fd, static_cast<short>(op.kind == Kind::read ? POLLIN : POLLOUT), 0});
+                s.polled.push_back(i);
+                continue;
+            }
+#endif
+            s.unpolled.push_back(i);
+        }
+
+        // descriptor-less drivers: just try them, they cannot be waited on
+        bool progressed = false;
+        for (const std::size_t i : s.unpolled)
+        {
+            const std::size_t before = ops[i].transferred;
+            attempt(ops[i]);
+            progressed |= ops[i].transferred != before;
+        }
+
+        auto waitFor = std::chrono::ceil<std::chrono::milliseconds>(wakeAt - now);
+        if (progressed || finished > 0)
+            waitFor = std::chrono::milliseconds{0};
+        else if (!s.unpolled.empty())
+            waitFor = std::min(waitFor, kFallbackSlice);
+        waitFor = std::max(waitFor, std::chrono::milliseconds{0});
+
+#ifndef _WIN32
+        if (!s.fds.empty())
+        {
+            // the one syscall that covers the whole batch
+            int ready = ::poll(s.fds.data(), static_cast<nfds_t>(s.fds.size()), static_cast<int>(waitFor.count()));
+            if (ready < 0 && errno != EINTR)
+            {
+                for (const std::size_t i : s.polled)
+                {
+                    ops[i].error = std::error_code(errno, std::system_category());
+                    complete(ops[i], Status::failed);
+                }
+                return finished;
+            }
+            for (std::size_t k = 0; k < s.fds.size() && ready > 0; ++k)
+            {
+                const short revents = s.fds[k].revents;
+                if (revents == 0)
+                    continue;
+                --ready;
+                Operation &op = ops[s.polled[k]];
+                const std::size_t before = op.transferred;
+                attempt(op);
+
+                // a dead descriptor polls ready forever; once it yields nothing, give up on it
+                if (op.status == Status::pending && op.transferred == before && (revents & (POLLHUP | POLLERR | POLLNVAL)))
+                {
+                    const auto error = (revents & POLLNVAL) ? std::errc::bad_file_descriptor
+                                     : (revents & POLLHUP)  ? std::errc::connection_reset
+                                                            : std::errc::io_error;
+                    op.error = std::make_error_code(error);
+                    complete(op, Status::failed);
+                }
+            }
+            return finished;
+        }
+#endif
+        if (!s.unpolled.empty() && waitFor.count() > 0)
+            std::this_thread::sleep_for(waitFor);
+        return finished;
+    }
+
+    std::size_t FleetIo::run(std::span<Operation> ops, const Completion &onComplete)
+    {
+        std::size_t done = 0;
+        auto count = [&](Operation &op) {
+            if (op.status == Status::done)
+                ++done;
+            if (onComplete)
+                onComplete(op);
+        };
+
+        auto pending = [&] {
+            return std::any_of(ops.begin(), ops.end(), [](const Operation &op) { return op.status == Status::pending; });
+        };
+        while (pending())
+        {
+            // step() caps the wait at the earliest deadline in the batch
+            (void)step(ops, std::chrono::hours{1}, count);
+        }
+        return done;
+    }
+
+    bool FleetIo::transfer_(Operation &op)
+    {
+        const std::chrono::milliseconds noWait{0};
+        if (op.kind == Kind::read)
+        {
+            op.transferred += op.driver->readSome(op.data + op.transferred, op.size - op.transferred, noWait);
+            return op.transferred >= std::min(op.minBytes, op.size);
+        }
+
+        while (op.transferred < op.size)
+        {
+            const std::size_t w = op.driver->writeSome(op.data + op.transferred, op.size - op.transferred, noWait);
+            if (w == 0)
+                return false;
+            op.transferred += w;
+        }
+        return true;
+    }
+}
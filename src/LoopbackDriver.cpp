@@ -1,7 +1,9 @@
 //
 // Created by didal on 25/08/2025.
 //
+#include <algorithm>
 #include <cstring>
+#include <span>
 #include "../include/ComLibPP/LoopbackDriver.h"
 
 namespace ucpgr
@@ -51,6 +53,7 @@ namespace ucpgr
         if (isOpen())
         {
             m_Buffer.clear();
+            m_TxQueued = 0;
             m_IsOpen = false;
         }
     }
@@ -89,6 +92,9 @@ namespace ucpgr
         std::span data{src, n};
         m_Buffer.insert(m_Buffer.end(), data.begin(), data.end());
 
+        m_TxQueued = bytesPending() + n;
+        m_TxQueuedAt = std::chrono::steady_clock::now();
+
         return n;
     }
 
@@ -100,6 +106,16 @@ namespace ucpgr
         return m_Buffer.size();
     }
 
+    [[nodiscard]] std::size_t LoopbackDriver::bytesPending() const
+    {
+        if (!isOpen() || m_TxQueued == 0 || m_Settings.baud == 0)
+            return 0;
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_TxQueuedAt;
+        const double drained = elapsed.count() * m_Settings.baud / m_Settings.bitsPerChar();
+        return drained >= static_cast<double>(m_TxQueued) ? 0 : m_TxQueued - static_cast<std::size_t>(drained);
+    }
+
     void LoopbackDriver::cancelIo()
     {
         m_IsOpen = false;
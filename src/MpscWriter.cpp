@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <ComLibPP/MpscWriter.hpp>
+
+namespace ucpgr
+{
+    MpscWriter::MpscWriter(SerialStreamBuf &out) : MpscWriter(out, Options{})
+    {
+    }
+
+    MpscWriter::MpscWriter(SerialStreamBuf &out, const Options &options)
+        : m_Out(out), m_Options(options),
+          m_Capacity(std::bit_ceil(std::max<uint64_t>(options.ringBytes, 4 * kAlign))),
+          m_Mask(m_Capacity - 1),
+          m_Ring(std::make_unique<uint64_t[]>(m_Capacity / kWord)),
+          m_Stamps(std::make_unique<std::atomic<uint64_t>[]>(m_Capacity / kAlign))
+    {
+        m_Staging.reserve(m_Capacity);
+    }
+
+    bool MpscWriter::submit(std::span<const uint8_t> message)
+    {
+        if (message.empty())
+        {
+            return true;
+        }
+        const uint64_t size = recordSize_(message.size());
+        if (size > m_Capacity || message.size() > std::numeric_limits<uint32_t>::max())
+        {
+            return false;
+        }
+
+        uint64_t position = 0;
+        if (!reserve_(size, position))
+        {
+            return false;
+        }
+
+        // headers are 16-byte aligned and never straddle the wrap; payloads may
+        const uint32_t header[2] = {static_cast<uint32_t>(message.size()), 0};
+        copyIn_(position, reinterpret_cast<const uint8_t*>(header), kHeader);
+        copyIn_(position + kHeader, message.data(), message.size());
+        stamp_(position).store(position + 1, std::memory_order_release);
+
+        if (m_Options.flushOnSubmit)
+        {
+            flush();
+        }
+        return true;
+    }
+
+    std::size_t MpscWriter::flush()
+    {
+        std::size_t total = 0;
+        for (;;)
+        {
+            if (m_Flushing.test_and_set(std::memory_order_acquire))
+            {
+                return total;
+            }
+            total += drain_();
+            m_Flushing.clear(std::memory_order_release);
+
+            // a record committed while we held the flag may have had its flush refused
+            if (!committedAtHead_())
+            {
+                return total;
+            }
+        }
+    }
+
+    std::size_t MpscWriter::pendingBytes() const
+    {
+        const uint64_t head = m_Head.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(m_Tail.load(std::memory_order_acquire) - head);
+    }
+
+    void MpscWriter::copyIn_(uint64_t position, const uint8_t *src, std::size_t n)
+    {
+        // a record owns every word it touches, so the tail of the last one is ours to pad
+        for (std::size_t done = 0; done < n; done += kWord)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, src + done, std::min(kWord, n - done));
+            std::atomic_ref(m_Ring[((position + done) & m_Mask) / kWord]).store(word, std::memory_order_relaxed);
+        }
+    }
+
+    void MpscWriter::copyOut_(uint64_t position, uint8_t *dst, std::size_t n) const
+    {
+        for (std::size_t done = 0; done < n; done += kWord)
+        {
+            const uint64_t word = std::atomic_ref(m_Ring[((position + done) & m_Mask) / kWord]).load(std::memory_order_relaxed);
+            std::memcpy(dst + done, &word, std::min(kWord, n - done));
+        }
+    }
+
+    bool MpscWriter::reserve_(uint64_t size, uint64_t &position)
+    {
+        for (;;)
+        {
+            // head first: a stale head only overstates what is in use
+            const uint64_t head = m_Head.load(std::memory_order_acquire);
+            uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail - head + size <= m_Capacity)
+            {
+                if (m_Tail.compare_exchange_weak(tail, tail + size, std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    position = tail;
+                    return true;
+                }
+                continue;
+            }
+
+            switch (m_Options.policy)
+            {
+                case FullPolicy::failFast:
+                    return false;
+
+                case FullPolicy::dropOldest:
+                    if (!dropOldest_(head))
+                    {
+                        std::this_thread::yield();  // oldest record is still being written
+                    }
+                    break;
+
+                case FullPolicy::block:
+                    if (m_Options.flushOnSubmit && flush() > 0)
+                    {
+                        break;
+                    }
+                    // the flusher, or the producer still filling the oldest record, moves head on
+                    m_Head.wait(head, std::memory_order_acquire);
+                    break;
+            }
+        }
+    }
+
+    bool MpscWriter::dropOldest_(uint64_t head)
+    {
+        if (stamp_(head).load(std::memory_order_acquire) != head + 1)
+        {
+            return false;
+        }
+        uint32_t length = 0;
+        copyOut_(head, reinterpret_cast<uint8_t*>(&length), sizeof(length));
+
+        // losing the race means someone else freed space, which is just as good
+        uint64_t expected = head;
+        if (m_Head.compare_exchange_strong(expected, head + recordSize_(length), std::memory_order_acq_rel))
+        {
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            m_Head.notify_all();
+        }
+        return true;
+    }
+
+    bool MpscWriter::committedAtHead_() const
+    {
+        const uint64_t head = m_Head.load(std::memory_order_acquire);
+        return head != m_Tail.load(std::memory_order_acquire) &&
+               stamp_(head).load(std::memory_order_acquire) == head + 1;
+    }
+
+    std::size_t MpscWriter::drain_()
+    {
+        std::size_t written = 0;
+        for (;;)
+        {
+            uint64_t head = m_Head.load(std::memory_order_acquire);
+            const uint64_t tail = m_Tail.load(std::memory_order_acquire);
+
+            // copy the committed prefix out; it stays ours until head moves past it
+            m_Staging.clear();
+            uint64_t position = head;
+            while (position != tail && stamp_(position).load(std::memory_order_acquire) == position + 1)
+            {
+                uint32_t length = 0;
+                copyOut_(position, reinterpret_cast<uint8_t*>(&length), sizeof(length));
+                if (recordSize_(length) > tail - position)
+                {
+                    break;  // torn by a concurrent drop; the CAS below will fail
+                }
+                const std::size_t at = m_Staging.size();
+                m_Staging.resize(at + length);
+                copyOut_(position + kHeader, m_Staging.data() + at, length);
+                position += recordSize_(length);
+            }
+            if (position == head)
+            {
+                return written;
+            }
+
+            // dropOldest may have reclaimed part of what we copied: start over
+            if (!m_Head.compare_exchange_strong(head, position, std::memory_order_acq_rel))
+            {
+                continue;
+            }
+            m_Head.notify_all();
+
+            // one writeSome for the batch where the driver takes it; head has already moved,
+            // so whatever a timed-out write leaves is lost (counted in shortWrites)
+            const std::size_t n = m_Out.writeThrough(m_Staging);
+            if (n != m_Staging.size())
+            {
+                m_ShortWrites.fetch_add(1, std::memory_order_relaxed);
+            }
+            written += n;
+        }
+    }
+}
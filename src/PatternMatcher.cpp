@@ -0,0 +1,90 @@
+#include <deque>
+#include <ComLibPP/PatternMatcher.hpp>
+
+namespace ucpgr
+{
+    PatternMatcher::PatternMatcher(std::span<const std::string_view> patterns)
+    {
+        // byte classes: every distinct pattern byte gets its own, everything else shares 0
+        for (const auto pattern : patterns)
+        {
+            for (const char c : pattern)
+            {
+                auto &cls = m_ClassOf[static_cast<uint8_t>(c)];
+                if (cls == 0)
+                    cls = static_cast<uint16_t>(m_Classes++);
+            }
+        }
+
+        // trie; kStart is the root, missing edges stay kNone until the BFS below fills them
+        constexpr State kNone = static_cast<State>(-1);
+        m_Next.assign(m_Classes, kNone);
+        m_Match.assign(1, -1);
+        m_Depth.assign(1, 0);
+
+        for (std::size_t p = 0; p < patterns.size(); ++p)
+        {
+            m_Lengths.push_back(patterns[p].size());
+            if (patterns[p].empty())
+                continue;
+
+            State s = kStart;
+            for (const char c : patterns[p])
+            {
+                const std::size_t edge = s * m_Classes + m_ClassOf[static_cast<uint8_t>(c)];
+                if (m_Next[edge] == kNone)
+                {
+                    m_Next[edge] = static_cast<State>(m_Match.size());
+                    m_Next.resize(m_Next.size() + m_Classes, kNone);
+                    m_Match.push_back(-1);
+                    m_Depth.push_back(m_Depth[s] + 1);
+                }
+                s = m_Next[edge];
+            }
+            if (m_Match[s] < 0)
+                m_Match[s] = static_cast<int>(p);
+        }
+
+        // failure links folded into the table (BFS), so matching never backtracks
+        std::vector<State> fail(m_Match.size(), kStart);
+        std::deque<State> queue;
+        for (std::size_t c = 0; c < m_Classes; ++c)
+        {
+            State &to = m_Next[c];
+            if (to == kNone)
+            {
+                to = kStart;
+            }
+            else
+            {
+                fail[to] = kStart;
+                queue.push_back(to);
+            }
+        }
+
+        while (!queue.empty())
+        {
+            const State s = queue.front();
+            queue.pop_front();
+
+            const int inherited = m_Match[fail[s]];
+            if (inherited >= 0 && (m_Match[s] < 0 || inherited < m_Match[s]))
+                m_Match[s] = inherited;
+
+            for (std::size_t c = 0; c < m_Classes; ++c)
+            {
+                State &to = m_Next[s * m_Classes + c];
+                const State viaFail = m_Next[fail[s] * m_Classes + c];
+                if (to == kNone)
+                {
+                    to = viaFail;
+                }
+                else
+                {
+                    fail[to] = viaFail;
+                    queue.push_back(to);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,354 @@
+#ifdef __linux__
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+// termios2/BOTHER live in the kernel headers, which clash with <termios.h>
+#include <asm/termbits.h>
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <ComLibPP/PosixSerialDriver.hpp>
+
+namespace ucpgr
+{
+    PosixSerial::PosixSerial(std::string portName, const SerialSettings &settings, const TimeoutPolicy &timeoutPolicy)
+        : m_Policy(timeoutPolicy), m_Settings(settings)
+    {
+        this->open(std::move(portName), m_Settings, m_Policy);
+    }
+
+    PosixSerial::PosixSerial(std::string portName, uint32_t baud)
+        : m_Policy({}), m_Settings({.baud=baud})
+    {
+        this->open(std::move(portName), m_Settings, m_Policy);
+    }
+
+    PosixSerial::~PosixSerial()
+    {
+        PosixSerial::close();
+    }
+
+    void PosixSerial::open(std::string portName, const SerialSettings &settings, const TimeoutPolicy &timeoutPolicy)
+    {
+        close();
+
+        m_Policy = timeoutPolicy;
+        m_Fd = ::open(portName.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if (m_Fd < 0)
+        {
+            throwErrno_("open");
+        }
+
+        try
+        {
+            int wake[2];
+            if (::pipe2(wake, O_NONBLOCK | O_CLOEXEC) != 0)
+            {
+                throwErrno_("pipe2");
+            }
+            m_WakeRead = wake[0];
+            m_WakeWrite = wake[1];
+
+            (void)::ioctl(m_Fd, TIOCEXCL);
+            setLineCoding(settings);
+            enableLowLatency_(portName);
+            (void)::ioctl(m_Fd, TCFLSH, TCIOFLUSH);
+        }
+        catch (...)
+        {
+            close();
+            throw;
+        }
+    }
+
+    void PosixSerial::open(std::string portName, uint32_t baud)
+    {
+        open(std::move(portName), {.baud=baud}, {});
+    }
+
+    [[nodiscard]] bool PosixSerial::isOpen() const
+    {
+        return m_Fd >= 0;
+    }
+
+    void PosixSerial::close()
+    {
+        if (m_Fd >= 0)
+        {
+            ::close(m_Fd);
+            m_Fd = -1;
+        }
+        if (m_WakeRead >= 0)
+        {
+            ::close(m_WakeRead);
+            ::close(m_WakeWrite);
+            m_WakeRead = m_WakeWrite = -1;
+        }
+        m_ActualBaud = 0;
+        m_LowLatency = false;
+    }
+
+    void PosixSerial::setLineCoding(const SerialSettings &settings)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "setLineCoding on closed port");
+        }
+        if (settings.dataBits < 5 || settings.dataBits > 8 || settings.baud == 0)
+        {
+            throw SerialError(std::make_error_code(std::errc::invalid_argument), "setLineCoding");
+        }
+
+        termios2 tio{};
+        if (::ioctl(m_Fd, TCGETS2, &tio) != 0)
+        {
+            throwErrno_("TCGETS2");
+        }
+
+        // raw: no line discipline processing, reads return whatever arrived (we poll)
+        tio.c_iflag = settings.parity == Parity::none ? 0 : INPCK;
+        tio.c_oflag = 0;
+        tio.c_lflag = 0;
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+
+        static constexpr tcflag_t kSizes[] = {CS5, CS6, CS7, CS8};
+        tio.c_cflag = CLOCAL | CREAD | kSizes[settings.dataBits - 5];
+        switch (settings.parity)
+        {
+            case Parity::none:  break;
+            case Parity::even:  tio.c_cflag |= PARENB; break;
+            case Parity::odd:   tio.c_cflag |= PARENB | PARODD; break;
+            case Parity::mark:  tio.c_cflag |= PARENB | CMSPAR | PARODD; break;
+            case Parity::space: tio.c_cflag |= PARENB | CMSPAR; break;
+        }
+        if (settings.stopBits != StopBits::one)
+        {
+            tio.c_cflag |= CSTOPB;
+        }
+
+        // BOTHER: the rate is taken from c_ospeed/c_ispeed instead of the Bxxxx table
+        tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+        tio.c_ospeed = settings.baud;
+        tio.c_ispeed = settings.baud;
+        if (::ioctl(m_Fd, TCSETS2, &tio) != 0)
+        {
+            throwErrno_("TCSETS2");
+        }
+
+        // the driver rounds to what its divisor can do; keep what it settled on
+        termios2 actual{};
+        if (::ioctl(m_Fd, TCGETS2, &actual) != 0)
+        {
+            throwErrno_("TCGETS2");
+        }
+        m_ActualBaud = actual.c_ospeed;
+        m_Settings = settings;
+    }
+
+    void PosixSerial::setTimeouts(const TimeoutPolicy &policy)
+    {
+        m_Policy = policy;
+    }
+
+    std::size_t PosixSerial::readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout)
+    {
+        return read_(dst, maxBytes, timeout, nullptr);
+    }
+
+    std::size_t PosixSerial::readSomeTimestamped(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout,
+                                                 RxTimestamp &stamp)
+    {
+        return read_(dst, maxBytes, timeout, &stamp);
+    }
+
+    std::size_t PosixSerial::read_(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout, RxTimestamp *stamp)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "readSome on closed port");
+        }
+
+        // only a cancelIo from here on ends this call
+        const uint32_t cancelGen = m_CancelGen.load(std::memory_order_acquire);
+        bool waited = false;
+        for (;;)
+        {
+            const auto got = ::read(m_Fd, dst, maxBytes);
+            if (got > 0)
+            {
+                if (stamp && !waited)
+                {
+                    *stamp = RxTimestamp::now();
+                }
+                return static_cast<std::size_t>(got);
+            }
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got < 0 && errno != EAGAIN)
+            {
+                throwErrno_("read");
+            }
+            if (waited || timeout.count() == 0 || !waitPort_(POLLIN, timeout, cancelGen))
+            {
+                return 0;
+            }
+            // stamp at the readiness event, not after the copy
+            if (stamp)
+            {
+                *stamp = RxTimestamp::now();
+            }
+            waited = true;
+        }
+    }
+
+    std::size_t PosixSerial::writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds timeout)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "writeSome on closed port");
+        }
+
+        const uint32_t cancelGen = m_CancelGen.load(std::memory_order_acquire);
+        bool waited = false;
+        for (;;)
+        {
+            const auto w = ::write(m_Fd, src, n);
+            if (w >= 0)
+            {
+                return static_cast<std::size_t>(w);
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN)
+            {
+                throwErrno_("write");
+            }
+            if (waited || timeout.count() == 0 || !waitPort_(POLLOUT, timeout, cancelGen))
+            {
+                return 0;
+            }
+            waited = true;
+        }
+    }
+
+    [[nodiscard]] std::size_t PosixSerial::bytesAvailable() const
+    {
+        int n = 0;
+        return isOpen() && ::ioctl(m_Fd, TIOCINQ, &n) == 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+    [[nodiscard]] std::size_t PosixSerial::bytesPending() const
+    {
+        int n = 0;
+        return isOpen() && ::ioctl(m_Fd, TIOCOUTQ, &n) == 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+    void PosixSerial::cancelIo()
+    {
+        if (m_WakeWrite >= 0)
+        {
+            m_CancelGen.fetch_add(1, std::memory_order_acq_rel);
+            const uint8_t b = 1;
+            (void)::write(m_WakeWrite, &b, 1);
+        }
+    }
+
+    int PosixSerial::pollDescriptor() const
+    {
+        return m_Fd;
+    }
+
+    const PosixSerial::TimeoutPolicy &PosixSerial::getTimeoutPolicy() const
+    {
+        return m_Policy;
+    }
+
+    const PosixSerial::SerialSettings &PosixSerial::getSerialSettings() const
+    {
+        return m_Settings;
+    }
+
+    void PosixSerial::enableLowLatency_(const std::string &portName)
+    {
+        // 8250-style UARTs: skip the flip-buffer deferral
+        serial_struct serial{};
+        if (::ioctl(m_Fd, TIOCGSERIAL, &serial) == 0)
+        {
+            serial.flags |= ASYNC_LOW_LATENCY;
+            m_LowLatency = ::ioctl(m_Fd, TIOCSSERIAL, &serial) == 0;
+        }
+
+        // FTDI bridges hold partial USB packets for latency_timer ms (16 by default)
+        char resolved[PATH_MAX];
+        if (::realpath(portName.c_str(), resolved) != nullptr)
+        {
+            const std::string tty = std::string(resolved).substr(std::string(resolved).rfind('/') + 1);
+            std::ofstream timer("/sys/bus/usb-serial/devices/" + tty + "/latency_timer");
+            if (timer && (timer << "1").flush())
+            {
+                m_LowLatency = true;
+            }
+        }
+    }
+
+    bool PosixSerial::waitPort_(short events, std::chrono::milliseconds timeout, uint32_t cancelGen)
+    {
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = std::chrono::steady_clock::now() + (infinite ? std::chrono::milliseconds{0} : timeout);
+        pollfd fds[2] = {{m_Fd, events, 0}, {m_WakeRead, POLLIN, 0}};
+        for (;;)
+        {
+            if (m_CancelGen.load(std::memory_order_acquire) != cancelGen)
+            {
+                return false;
+            }
+            const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            const int r = ::poll(fds, 2, infinite ? -1 : static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0)));
+            if (r < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (r < 0)
+            {
+                throwErrno_("poll");
+            }
+            if (fds[1].revents & POLLIN)
+            {
+                // a cancel for us leaves the byte for any other waiter (the other direction)
+                if (m_CancelGen.load(std::memory_order_acquire) != cancelGen)
+                {
+                    return false;
+                }
+                // left over from a cancel that predates us: clear it and wait again. A cancel
+                // racing the drain has bumped the generation; put its byte back for the others
+                uint8_t drain[16];
+                while (::read(m_WakeRead, drain, sizeof drain) > 0) {}
+                if (m_CancelGen.load(std::memory_order_acquire) != cancelGen)
+                {
+                    const uint8_t b = 1;
+                    (void)::write(m_WakeWrite, &b, 1);
+                    return false;
+                }
+                continue;
+            }
+            return r > 0;
+        }
+    }
+
+    void PosixSerial::throwErrno_(const char* what)
+    {
+        throw SerialError(std::error_code(errno, std::system_category()), what);
+    }
+}
+
+#endif // __linux__
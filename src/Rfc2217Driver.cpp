@@ -0,0 +1,775 @@
+#ifndef _WIN32
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <ComLibPP/Rfc2217Driver.hpp>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace ucpgr
+{
+    namespace
+    {
+        // telnet
+        constexpr uint8_t kIac  = 255;
+        constexpr uint8_t kDont = 254;
+        constexpr uint8_t kDo   = 253;
+        constexpr uint8_t kWont = 252;
+        constexpr uint8_t kWill = 251;
+        constexpr uint8_t kSb   = 250;
+        constexpr uint8_t kSe   = 240;
+
+        constexpr uint8_t kOptBinary  = 0;
+        constexpr uint8_t kOptSga     = 3;
+        constexpr uint8_t kOptComPort = 44;
+
+        // COM-PORT-OPTION commands (client -> server; server answers with +100)
+        constexpr uint8_t kSetBaudRate = 1;
+        constexpr uint8_t kSetDataSize = 2;
+        constexpr uint8_t kSetParity   = 3;
+        constexpr uint8_t kSetStopSize = 4;
+        constexpr uint8_t kPurgeData   = 12;
+        constexpr uint8_t kServerBase  = 100;
+
+        // escaped bytes one writeSome puts in front of the socket
+        constexpr std::size_t kTxChunk = 64 * 1024;
+
+        uint8_t toRfcParity(ISerialDriver::Parity p)
+        {
+            switch (p)
+            {
+                case ISerialDriver::Parity::none:  return 1;
+                case ISerialDriver::Parity::odd:   return 2;
+                case ISerialDriver::Parity::even:  return 3;
+                case ISerialDriver::Parity::mark:  return 4;
+                case ISerialDriver::Parity::space: return 5;
+            }
+            return 1;
+        }
+
+        uint8_t toRfcStopSize(ISerialDriver::StopBits s)
+        {
+            switch (s)
+            {
+                case ISerialDriver::StopBits::one:          return 1;
+                case ISerialDriver::StopBits::two:          return 2;
+                case ISerialDriver::StopBits::onePointFive: return 3;
+            }
+            return 1;
+        }
+
+        // append src to out with every 0xFF doubled; memchr is the vectorised scan
+        void appendEscaped(std::vector<uint8_t> &out, const uint8_t* src, std::size_t n)
+        {
+            const uint8_t* end = src + n;
+            while (src < end)
+            {
+                const auto* iac = static_cast<const uint8_t*>(std::memchr(src, kIac, static_cast<std::size_t>(end - src)));
+                const uint8_t* runEnd = iac ? iac + 1 : end;
+                out.insert(out.end(), src, runEnd);
+                if (iac)
+                {
+                    out.push_back(kIac);
+                }
+                src = runEnd;
+            }
+        }
+
+        // how many of src's n bytes fit in `room` once every 0xFF is doubled
+        std::size_t escapedFit(const uint8_t* src, std::size_t n, std::size_t room)
+        {
+            std::size_t taken = 0;
+            while (taken < n)
+            {
+                const auto* iac = static_cast<const uint8_t*>(std::memchr(src + taken, kIac, n - taken));
+                const std::size_t run = iac ? static_cast<std::size_t>(iac - (src + taken)) : n - taken;
+                if (run >= room)
+                {
+                    return taken + room;
+                }
+                taken += run;
+                room -= run;
+                if (!iac || room < 2)
+                {
+                    return taken;
+                }
+                ++taken;
+                room -= 2;
+            }
+            return taken;
+        }
+
+        int toPollMs(std::chrono::steady_clock::time_point deadline, bool infinite)
+        {
+            if (infinite)
+            {
+                return -1;
+            }
+            const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            return left.count() > 0 ? static_cast<int>(left.count()) : 0;
+        }
+    }
+
+    Rfc2217Driver::Rfc2217Driver(std::string portName, const SerialSettings &settings,
+                                 const TimeoutPolicy &timeoutPolicy) : m_Policy(timeoutPolicy), m_Settings(settings)
+    {
+        this->open(std::move(portName), m_Settings, m_Policy);
+    }
+
+    Rfc2217Driver::Rfc2217Driver(std::string portName, uint32_t baud)
+    {
+        this->open(std::move(portName), baud);
+    }
+
+    Rfc2217Driver::~Rfc2217Driver()
+    {
+        Rfc2217Driver::close();
+    }
+
+    void Rfc2217Driver::open(std::string portName, const SerialSettings &settings, const TimeoutPolicy &timeoutPolicy)
+    {
+        close();
+
+        m_Settings = settings;
+        m_Policy = timeoutPolicy;
+
+        if (portName.rfind("rfc2217://", 0) == 0)
+        {
+            portName.erase(0, 10);
+        }
+
+        std::string host;
+        std::string service;
+        if (!portName.empty() && portName.front() == '[')
+        {
+            const auto close = portName.find(']');
+            if (close == std::string::npos || close + 1 >= portName.size() || portName[close + 1] != ':')
+            {
+                throw SerialError(std::make_error_code(std::errc::invalid_argument), "rfc2217: expected [host]:port");
+            }
+            host = portName.substr(1, close - 1);
+            service = portName.substr(close + 2);
+        }
+        else
+        {
+            const auto colon = portName.rfind(':');
+            if (colon == std::string::npos)
+            {
+                throw SerialError(std::make_error_code(std::errc::invalid_argument), "rfc2217: expected host:port");
+            }
+            host = portName.substr(0, colon);
+            service = portName.substr(colon + 1);
+        }
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* list = nullptr;
+        if (getaddrinfo(host.c_str(), service.c_str(), &hints, &list) != 0)
+        {
+            throw SerialError(std::make_error_code(std::errc::host_unreachable), "rfc2217: getaddrinfo");
+        }
+
+        // the OS connect timeout can be minutes; bound each attempt by the write timeout instead
+        const auto connectTimeout = m_Policy.mode == TimeoutMode::blocking ? std::chrono::milliseconds{-1} : m_Policy.writeTimeout;
+        int lastErr = 0;
+        for (addrinfo* ai = list; ai; ai = ai->ai_next)
+        {
+            const int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0)
+            {
+                lastErr = errno;
+                continue;
+            }
+            lastErr = connect_(fd, ai->ai_addr, ai->ai_addrlen, connectTimeout);
+            if (lastErr == 0)
+            {
+                m_Socket = fd;
+                break;
+            }
+            ::close(fd);
+        }
+        freeaddrinfo(list);
+
+        if (m_Socket < 0)
+        {
+            throw SerialError(std::error_code(lastErr, std::system_category()), "rfc2217: connect");
+        }
+
+        try
+        {
+            // no Nagle delay on small commands; queued commands ride along with the next data
+            const int one = 1;
+            if (setsockopt(m_Socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one) != 0)
+            {
+                throwErrno_("setsockopt(TCP_NODELAY)");
+            }
+            int wake[2];
+            if (::pipe(wake) != 0)
+            {
+                throwErrno_("pipe");
+            }
+            m_WakeRead = wake[0];
+            m_WakeWrite = wake[1];
+
+            for (const int fd : {m_Socket, m_WakeRead, m_WakeWrite})
+            {
+                if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) != 0)
+                {
+                    throwErrno_("fcntl");
+                }
+            }
+
+            m_RxState = RxState::data;
+            m_SubNeg.clear();
+            m_Tx.clear();
+            m_Confirmed = {};
+            m_Confirmed.baud = 0; // unknown until the server answers
+
+            const uint8_t negotiate[] = {
+                kIac, kWill, kOptBinary, kIac, kDo, kOptBinary,
+                kIac, kWill, kOptSga,    kIac, kDo, kOptSga,
+                kIac, kWill, kOptComPort
+            };
+            m_Tx.insert(m_Tx.end(), std::begin(negotiate), std::end(negotiate));
+
+            setLineCoding(m_Settings);
+
+            const uint8_t purgeBoth = 3;
+            queueComPort_(kPurgeData, &purgeBoth, 1);
+            if (!flushTx_(m_Policy.writeTimeout))
+            {
+                throw SerialError(std::make_error_code(std::errc::timed_out), "rfc2217: negotiation");
+            }
+        }
+        catch (...)
+        {
+            close();
+            throw;
+        }
+    }
+
+    void Rfc2217Driver::open(std::string portName, uint32_t baud)
+    {
+        open(std::move(portName), {.baud=baud}, {});
+    }
+
+    [[nodiscard]] bool Rfc2217Driver::isOpen() const
+    {
+        return m_Socket >= 0;
+    }
+
+    void Rfc2217Driver::close()
+    {
+        if (isOpen())
+        {
+            try
+            {
+                // commands still queued get one write timeout to leave
+                (void)flushTx_(std::max(m_Policy.writeTimeout, std::chrono::milliseconds{0}));
+            }
+            catch (...)
+            {
+                // peer already gone; nothing left to deliver
+            }
+            ::close(m_Socket);
+            m_Socket = -1;
+        }
+        if (m_WakeRead >= 0)
+        {
+            ::close(m_WakeRead);
+            ::close(m_WakeWrite);
+            m_WakeRead = m_WakeWrite = -1;
+        }
+    }
+
+    void Rfc2217Driver::setLineCoding(const SerialSettings &settings)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "setLineCoding on closed port");
+        }
+
+        m_Settings = settings;
+
+        const uint8_t baud[] = {
+            static_cast<uint8_t>(settings.baud >> 24), static_cast<uint8_t>(settings.baud >> 16),
+            static_cast<uint8_t>(settings.baud >> 8),  static_cast<uint8_t>(settings.baud)
+        };
+        const uint8_t dataSize = settings.dataBits;
+        const uint8_t parity = toRfcParity(settings.parity);
+        const uint8_t stopSize = toRfcStopSize(settings.stopBits);
+
+        queueComPort_(kSetBaudRate, baud, sizeof baud);
+        queueComPort_(kSetDataSize, &dataSize, 1);
+        queueComPort_(kSetParity, &parity, 1);
+        queueComPort_(kSetStopSize, &stopSize, 1);
+        (void)flushTx_(m_Policy.writeTimeout);
+    }
+
+    void Rfc2217Driver::setTimeouts(const TimeoutPolicy &policy)
+    {
+        m_Policy = policy;
+    }
+
+    std::size_t Rfc2217Driver::readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout)
+    {
+        return read_(dst, maxBytes, timeout, nullptr);
+    }
+
+    std::size_t Rfc2217Driver::readSomeTimestamped(uint8_t* dst, std::size_t maxBytes,
+                                                   std::chrono::milliseconds timeout, RxTimestamp &stamp)
+    {
+        return read_(dst, maxBytes, timeout, &stamp);
+    }
+
+    std::size_t Rfc2217Driver::read_(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout, RxTimestamp *stamp)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "readSome on closed port");
+        }
+        if (maxBytes == 0)
+        {
+            return 0;
+        }
+
+        clearCancel_();
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = std::chrono::steady_clock::now() + (infinite ? std::chrono::milliseconds{0} : timeout);
+
+        for (;;)
+        {
+            // commands still queued have to leave before their replies can arrive
+            if (!m_Tx.empty())
+            {
+                (void)flushTx_(std::chrono::milliseconds{0});
+            }
+            const short ready = waitSocket_(m_Tx.empty() ? POLLIN : POLLIN | POLLOUT,
+                                            std::chrono::milliseconds{toPollMs(deadline, infinite)});
+            if (ready == 0)
+            {
+                return 0;
+            }
+            if ((ready & (POLLIN | POLLHUP | POLLERR)) == 0)
+            {
+                // writable only: push the queue and wait again
+                if (!infinite && std::chrono::steady_clock::now() >= deadline)
+                {
+                    (void)flushTx_(std::chrono::milliseconds{0});
+                    return 0;
+                }
+                continue;
+            }
+            if (stamp)
+            {
+                *stamp = RxTimestamp::now();
+            }
+
+            // decode in place: unescaped output is never longer than the wire bytes
+            const ssize_t got = ::recv(m_Socket, dst, maxBytes, 0);
+            if (got == 0)
+            {
+                throw SerialError(std::make_error_code(std::errc::connection_reset), "rfc2217: connection closed by server");
+            }
+            if (got < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                {
+                    continue;
+                }
+                throwErrno_("recv");
+            }
+
+            const std::size_t out = decode_(dst, static_cast<std::size_t>(got));
+            if (!m_Tx.empty())
+            {
+                (void)flushTx_(std::chrono::milliseconds{0}); // negotiation replies
+            }
+            if (out > 0)
+            {
+                return out;
+            }
+            // only telnet commands arrived
+            if (!infinite && std::chrono::steady_clock::now() >= deadline)
+            {
+                return 0;
+            }
+        }
+    }
+
+    std::size_t Rfc2217Driver::writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds timeout)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "writeSome on closed port");
+        }
+
+        clearCancel_();
+
+        // queued commands go out ahead of this data, in the same send()
+        const std::size_t queued = m_Tx.size();
+        const std::size_t accepted = escapedFit(src, n, kTxChunk);
+        appendEscaped(m_Tx, src, accepted);
+        const std::size_t ours = m_Tx.size() - queued;
+        (void)flushTx_(timeout);
+
+        const std::size_t unsent = std::min(m_Tx.size(), ours);
+        if (unsent == 0)
+        {
+            return accepted;
+        }
+
+        // hand back what the socket did not take, except the second half of a split 0xFF pair
+        const std::size_t sentEscaped = ours - unsent;
+        std::size_t taken = 0;
+        std::size_t escaped = 0;
+        while (escaped < sentEscaped)
+        {
+            escaped += src[taken++] == kIac ? 2 : 1;
+        }
+        m_Tx.resize(m_Tx.size() - unsent + (escaped - sentEscaped));
+        return taken;
+    }
+
+    [[nodiscard]] std::size_t Rfc2217Driver::bytesAvailable() const
+    {
+        if (!isOpen())
+        {
+            return 0;
+        }
+        int n = 0;
+        if (ioctl(m_Socket, FIONREAD, &n) != 0)
+        {
+            return 0;
+        }
+        return static_cast<std::size_t>(n); // wire bytes, an upper bound
+    }
+
+    [[nodiscard]] std::size_t Rfc2217Driver::bytesPending() const
+    {
+        if (!isOpen())
+        {
+            return 0;
+        }
+        // our own queue plus the unsent part of the socket send queue; what the
+        // terminal server still holds is not visible from here
+        std::size_t pending = m_Tx.size();
+#ifdef TIOCOUTQ
+        int unsent = 0;
+        if (ioctl(m_Socket, TIOCOUTQ, &unsent) == 0 && unsent > 0)
+        {
+            pending += static_cast<std::size_t>(unsent);
+        }
+#endif
+        return pending;
+    }
+
+    void Rfc2217Driver::cancelIo()
+    {
+        if (m_WakeWrite >= 0)
+        {
+            const uint8_t b = 1;
+            (void)::write(m_WakeWrite, &b, 1);
+        }
+    }
+
+    int Rfc2217Driver::pollDescriptor() const
+    {
+        return m_Socket;
+    }
+
+    const Rfc2217Driver::TimeoutPolicy &Rfc2217Driver::getTimeoutPolicy() const
+    {
+        return m_Policy;
+    }
+
+    const Rfc2217Driver::SerialSettings &Rfc2217Driver::getSerialSettings() const
+    {
+        return m_Settings;
+    }
+
+    const Rfc2217Driver::SerialSettings &Rfc2217Driver::getConfirmedSettings() const
+    {
+        return m_Confirmed;
+    }
+
+    std::size_t Rfc2217Driver::decode_(uint8_t* buf, std::size_t n)
+    {
+        std::size_t r = 0;
+        std::size_t w = 0;
+        while (r < n)
+        {
+            if (m_RxState == RxState::data)
+            {
+                const auto* iac = static_cast<const uint8_t*>(std::memchr(buf + r, kIac, n - r));
+                const std::size_t run = iac ? static_cast<std::size_t>(iac - (buf + r)) : n - r;
+                if (w != r && run > 0)
+                {
+                    std::memmove(buf + w, buf + r, run);
+                }
+                w += run;
+                r += run;
+                if (!iac)
+                {
+                    break;
+                }
+                ++r;
+                m_RxState = RxState::iac;
+                continue;
+            }
+
+            const uint8_t c = buf[r++];
+            switch (m_RxState)
+            {
+                case RxState::iac:
+                {
+                    if (c == kIac)
+                    {
+                        buf[w++] = kIac;
+                        m_RxState = RxState::data;
+                    }
+                    else if (c == kSb)
+                    {
+                        m_SubNeg.clear();
+                        m_RxState = RxState::sub;
+                    }
+                    else if (c >= kWill)
+                    {
+                        m_RxVerb = c;
+                        m_RxState = RxState::option;
+                    }
+                    else
+                    {
+                        m_RxState = RxState::data; // NOP, GA, ... carry nothing for us
+                    }
+                    break;
+                }
+                case RxState::option:
+                {
+                    handleOption_(m_RxVerb, c);
+                    m_RxState = RxState::data;
+                    break;
+                }
+                case RxState::sub:
+                {
+                    if (c == kIac)
+                    {
+                        m_RxState = RxState::subIac;
+                    }
+                    else if (m_SubNeg.size() < 64)
+                    {
+                        m_SubNeg.push_back(c);
+                    }
+                    break;
+                }
+                case RxState::subIac:
+                {
+                    if (c == kSe)
+                    {
+                        handleSubnegotiation_();
+                        m_RxState = RxState::data;
+                    }
+                    else
+                    {
+                        if (c == kIac && m_SubNeg.size() < 64)
+                        {
+                            m_SubNeg.push_back(kIac);
+                        }
+                        m_RxState = RxState::sub;
+                    }
+                    break;
+                }
+                case RxState::data:
+                    break;
+            }
+        }
+        return w;
+    }
+
+    void Rfc2217Driver::handleOption_(uint8_t verb, uint8_t option)
+    {
+        // we already asked for everything we accept, so only refusals need an answer
+        if (verb == kWill && option != kOptBinary && option != kOptSga)
+        {
+            m_Tx.insert(m_Tx.end(), {kIac, kDont, option});
+        }
+        else if (verb == kDo && option != kOptBinary && option != kOptSga && option != kOptComPort)
+        {
+            m_Tx.insert(m_Tx.end(), {kIac, kWont, option});
+        }
+    }
+
+    void Rfc2217Driver::handleSubnegotiation_()
+    {
+        if (m_SubNeg.size() < 3 || m_SubNeg[0] != kOptComPort || m_SubNeg[1] < kServerBase)
+        {
+            return;
+        }
+
+        const uint8_t* v = m_SubNeg.data() + 2;
+        switch (m_SubNeg[1] - kServerBase)
+        {
+            case kSetBaudRate:
+            {
+                if (m_SubNeg.size() >= 6)
+                {
+                    m_Confirmed.baud = (uint32_t{v[0]} << 24) | (uint32_t{v[1]} << 16) | (uint32_t{v[2]} << 8) | v[3];
+                }
+                break;
+            }
+            case kSetDataSize:
+            {
+                m_Confirmed.dataBits = v[0];
+                break;
+            }
+            case kSetParity:
+            {
+                static constexpr Parity map[] = {Parity::none, Parity::odd, Parity::even, Parity::mark, Parity::space};
+                if (v[0] >= 1 && v[0] <= 5)
+                {
+                    m_Confirmed.parity = map[v[0] - 1];
+                }
+                break;
+            }
+            case kSetStopSize:
+            {
+                static constexpr StopBits map[] = {StopBits::one, StopBits::two, StopBits::onePointFive};
+                if (v[0] >= 1 && v[0] <= 3)
+                {
+                    m_Confirmed.stopBits = map[v[0] - 1];
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void Rfc2217Driver::queueComPort_(uint8_t command, const uint8_t* value, std::size_t n)
+    {
+        m_Tx.insert(m_Tx.end(), {kIac, kSb, kOptComPort, command});
+        appendEscaped(m_Tx, value, n);
+        m_Tx.insert(m_Tx.end(), {kIac, kSe});
+    }
+
+    bool Rfc2217Driver::flushTx_(std::chrono::milliseconds timeout)
+    {
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = std::chrono::steady_clock::now() + (infinite ? std::chrono::milliseconds{0} : timeout);
+
+        std::size_t done = 0;
+        bool drained = true;
+        while (done < m_Tx.size())
+        {
+            const ssize_t sent = ::send(m_Socket, m_Tx.data() + done, m_Tx.size() - done, MSG_NOSIGNAL);
+            if (sent > 0)
+            {
+                done += static_cast<std::size_t>(sent);
+                continue;
+            }
+            if (sent < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                throwErrno_("send");
+            }
+            if (timeout.count() == 0 || waitSocket_(POLLOUT, std::chrono::milliseconds{toPollMs(deadline, infinite)}) == 0)
+            {
+                drained = false;
+                break;
+            }
+        }
+
+        // keep only the unsent tail
+        m_Tx.erase(m_Tx.begin(), m_Tx.begin() + static_cast<std::ptrdiff_t>(done));
+        return drained;
+    }
+
+    short Rfc2217Driver::waitSocket_(short events, std::chrono::milliseconds timeout)
+    {
+        pollfd fds[2] = {{m_Socket, events, 0}, {m_WakeRead, POLLIN, 0}};
+        for (;;)
+        {
+            const int r = ::poll(fds, 2, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+            if (r < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (r < 0)
+            {
+                throwErrno_("poll");
+            }
+            if (fds[1].revents & POLLIN)
+            {
+                clearCancel_();
+                return 0;
+            }
+            return r > 0 ? fds[0].revents : 0;
+        }
+    }
+
+    void Rfc2217Driver::clearCancel_()
+    {
+        uint8_t drain[16];
+        while (::read(m_WakeRead, drain, sizeof drain) > 0) {}
+    }
+
+    int Rfc2217Driver::connect_(int fd, const sockaddr* addr, socklen_t len, std::chrono::milliseconds timeout)
+    {
+        if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0)
+        {
+            return errno;
+        }
+        if (::connect(fd, addr, len) == 0)
+        {
+            return 0;
+        }
+        if (errno != EINPROGRESS)
+        {
+            return errno;
+        }
+
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = std::chrono::steady_clock::now() + (infinite ? std::chrono::milliseconds{0} : timeout);
+        pollfd pfd{fd, POLLOUT, 0};
+        int r = 0;
+        while ((r = ::poll(&pfd, 1, toPollMs(deadline, infinite))) < 0 && errno == EINTR) {}
+        if (r < 0)
+        {
+            return errno;
+        }
+        if (r == 0)
+        {
+            return ETIMEDOUT;
+        }
+
+        int err = 0;
+        socklen_t errLen = sizeof err;
+        if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &errLen) != 0)
+        {
+            return errno;
+        }
+        return err;
+    }
+
+    void Rfc2217Driver::throwErrno_(const char* what)
+    {
+        throw SerialError(std::error_code(errno, std::system_category()), what);
+    }
+}
+
+#endif // _WIN32
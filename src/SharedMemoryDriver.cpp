@@ -0,0 +1,403 @@
+#ifdef __linux__
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ComLibPP/SharedMemoryDriver.hpp>
+
+namespace ucpgr
+{
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared rings need address-free atomics");
+
+    static constexpr uint32_t kMagic = 0x53484d31; // "SHM1"
+
+    // positions are free-running byte counters; capacity is a power of two
+    struct SharedMemoryDriver::Ring
+    {
+        alignas(64) std::atomic<uint32_t> tail {0};        // producer
+        std::atomic<uint32_t>             dataSeq {0};     // futex: bumped after publishing
+        std::atomic<uint32_t>             readerWaiting {0};
+        alignas(64) std::atomic<uint32_t> head {0};        // consumer
+        std::atomic<uint32_t>             spaceSeq {0};    // futex: bumped after consuming
+        std::atomic<uint32_t>             writerWaiting {0};
+    };
+
+    struct SharedMemoryDriver::Shared
+    {
+        std::atomic<uint32_t> magic {0};
+        uint32_t              capacity {0};
+        Ring                  rings[2];
+    };
+
+    SharedMemoryDriver::SharedMemoryDriver(std::string portName, Endpoint endpoint, const SerialSettings &settings,
+                                           const TimeoutPolicy &timeoutPolicy, std::size_t ringBytes)
+        : m_Endpoint(endpoint), m_RingBytes(ringBytes), m_Policy(timeoutPolicy), m_Settings(settings)
+    {
+        this->open(std::move(portName), m_Settings, m_Policy);
+    }
+
+    SharedMemoryDriver::~SharedMemoryDriver()
+    {
+        SharedMemoryDriver::close();
+    }
+
+    void SharedMemoryDriver::open(std::string portName, const SerialSettings &settings, const TimeoutPolicy &timeoutPolicy)
+    {
+        close();
+
+        m_Settings = settings;
+        m_Policy = timeoutPolicy;
+
+        const bool create = m_Endpoint == Endpoint::a;
+        if (portName.rfind("fd:", 0) == 0)
+        {
+            int fd = -1;
+            const char* first = portName.data() + 3;
+            const char* last = portName.data() + portName.size();
+            const auto [end, ec] = std::from_chars(first, last, fd);
+            if (ec != std::errc{} || end != last || fd < 0)
+            {
+                throw SerialError(std::make_error_code(std::errc::invalid_argument), "SharedMemoryDriver: expected fd:N");
+            }
+            m_Fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+        }
+        else if (portName.rfind("memfd:", 0) == 0)
+        {
+            if (!create)
+            {
+                throw SerialError(std::make_error_code(std::errc::invalid_argument), "memfd: endpoint b attaches with fd:N");
+            }
+            m_Fd = static_cast<int>(::syscall(SYS_memfd_create, portName.c_str() + 6, 0));
+        }
+        else
+        {
+            m_Fd = ::shm_open(portName.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT : 0), 0600);
+            if (create && m_Fd >= 0)
+            {
+                m_Unlink = portName;
+            }
+        }
+        if (m_Fd < 0)
+        {
+            throwErrno_("SharedMemoryDriver: open mapping");
+        }
+
+        try
+        {
+            // ring data follows the header, cache-line aligned
+            constexpr std::size_t offset = (sizeof(Shared) + 63) & ~std::size_t{63};
+            if (create)
+            {
+                m_Capacity = static_cast<uint32_t>(std::bit_ceil(std::clamp<std::size_t>(m_RingBytes, 64, std::size_t{1} << 30)));
+                m_MapSize = offset + 2 * std::size_t{m_Capacity};
+                if (::ftruncate(m_Fd, static_cast<off_t>(m_MapSize)) != 0)
+                {
+                    throwErrno_("ftruncate");
+                }
+            }
+            else
+            {
+                struct stat st{};
+                if (::fstat(m_Fd, &st) != 0)
+                {
+                    throwErrno_("fstat");
+                }
+                m_MapSize = static_cast<std::size_t>(st.st_size);
+                if (m_MapSize < offset)
+                {
+                    throw SerialError(std::make_error_code(std::errc::no_such_device), "SharedMemoryDriver: peer not initialised");
+                }
+            }
+
+            m_Map = ::mmap(nullptr, m_MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_Fd, 0);
+            if (m_Map == MAP_FAILED)
+            {
+                m_Map = nullptr;
+                throwErrno_("mmap");
+            }
+
+            if (create)
+            {
+                m_Shared = new (m_Map) Shared{};
+                m_Shared->capacity = m_Capacity;
+                m_Shared->magic.store(kMagic, std::memory_order_release);
+            }
+            else
+            {
+                m_Shared = static_cast<Shared*>(m_Map);
+                if (m_Shared->magic.load(std::memory_order_acquire) != kMagic)
+                {
+                    throw SerialError(std::make_error_code(std::errc::no_such_device), "SharedMemoryDriver: peer not initialised");
+                }
+                // read once: the segment belongs to another process and the ring masks trust this
+                m_Capacity = m_Shared->capacity;
+                if (m_Capacity == 0 || !std::has_single_bit(m_Capacity) || offset + 2 * std::size_t{m_Capacity} > m_MapSize)
+                {
+                    throw SerialError(std::make_error_code(std::errc::invalid_argument), "SharedMemoryDriver: bad ring capacity");
+                }
+            }
+
+            // a writes ring 0 and reads ring 1; b the other way round
+            auto *data = static_cast<uint8_t*>(m_Map) + offset;
+            const int tx = create ? 0 : 1;
+            m_Tx = &m_Shared->rings[tx];
+            m_Rx = &m_Shared->rings[1 - tx];
+            m_TxData = data + std::size_t{m_Capacity} * static_cast<std::size_t>(tx);
+            m_RxData = data + std::size_t{m_Capacity} * static_cast<std::size_t>(1 - tx);
+        }
+        catch (...)
+        {
+            close();
+            throw;
+        }
+    }
+
+    void SharedMemoryDriver::open(std::string portName, uint32_t baud)
+    {
+        open(std::move(portName), {.baud=baud}, {});
+    }
+
+    [[nodiscard]] bool SharedMemoryDriver::isOpen() const
+    {
+        return m_Shared != nullptr;
+    }
+
+    void SharedMemoryDriver::close()
+    {
+        if (m_Map)
+        {
+            ::munmap(m_Map, m_MapSize);
+            m_Map = nullptr;
+        }
+        if (m_Fd >= 0)
+        {
+            ::close(m_Fd);
+            m_Fd = -1;
+        }
+        if (!m_Unlink.empty())
+        {
+            ::shm_unlink(m_Unlink.c_str());
+            m_Unlink.clear();
+        }
+        m_Shared = nullptr;
+        m_Rx = m_Tx = nullptr;
+        m_RxData = m_TxData = nullptr;
+    }
+
+    void SharedMemoryDriver::setLineCoding(const SerialSettings &settings)
+    {
+        m_Settings = settings; // nothing to configure on a memory line
+    }
+
+    void SharedMemoryDriver::setTimeouts(const TimeoutPolicy &policy)
+    {
+        m_Policy = policy;
+    }
+
+    std::size_t SharedMemoryDriver::readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "readSome on closed port");
+        }
+
+        const uint32_t cancelGen = m_CancelGen.load(std::memory_order_acquire);
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = std::chrono::steady_clock::now() + (infinite ? std::chrono::milliseconds{0} : timeout);
+
+        for (;;)
+        {
+            const uint32_t head = m_Rx->head.load(std::memory_order_relaxed);
+            const uint32_t avail = m_Rx->tail.load(std::memory_order_acquire) - head;
+            if (avail > 0)
+            {
+                const auto n = static_cast<uint32_t>(std::min<std::size_t>(maxBytes, avail));
+                const uint32_t at = head & (m_Capacity - 1);
+                const uint32_t first = std::min(n, m_Capacity - at);
+                std::memcpy(dst, m_RxData + at, first);
+                std::memcpy(dst + first, m_RxData, n - first);
+                consume(n);
+                return n;
+            }
+            if (maxBytes == 0 || timeout.count() == 0)
+            {
+                return 0;
+            }
+
+            // announce, then re-check: the writer either sees us waiting or we see its data
+            m_Rx->readerWaiting.store(1, std::memory_order_seq_cst);
+            const uint32_t seen = m_Rx->dataSeq.load(std::memory_order_seq_cst);
+            const bool empty = m_Rx->tail.load(std::memory_order_seq_cst) == head;
+            const bool woke = !empty || wait_(m_Rx->dataSeq, seen, deadline, infinite, cancelGen);
+            m_Rx->readerWaiting.store(0, std::memory_order_relaxed);
+            if (!woke)
+            {
+                return 0;
+            }
+        }
+    }
+
+    std::size_t SharedMemoryDriver::writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds timeout)
+    {
+        if (!isOpen())
+        {
+            throw SerialError(std::make_error_code(std::errc::bad_file_descriptor), "writeSome on closed port");
+        }
+
+        const uint32_t cancelGen = m_CancelGen.load(std::memory_order_acquire);
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = std::chrono::steady_clock::now() + (infinite ? std::chrono::milliseconds{0} : timeout);
+
+        for (;;)
+        {
+            const uint32_t tail = m_Tx->tail.load(std::memory_order_relaxed);
+            const uint32_t space = m_Capacity - (tail - m_Tx->head.load(std::memory_order_acquire));
+            if (space > 0)
+            {
+                const auto count = static_cast<uint32_t>(std::min<std::size_t>(n, space));
+                const uint32_t at = tail & (m_Capacity - 1);
+                const uint32_t first = std::min(count, m_Capacity - at);
+                std::memcpy(m_TxData + at, src, first);
+                std::memcpy(m_TxData, src + first, count - first);
+
+                m_Tx->tail.store(tail + count, std::memory_order_seq_cst);
+                m_Tx->dataSeq.fetch_add(1, std::memory_order_seq_cst);
+                if (m_Tx->readerWaiting.load(std::memory_order_seq_cst))
+                {
+                    wake_(m_Tx->dataSeq);
+                }
+                return count;
+            }
+            if (n == 0 || timeout.count() == 0)
+            {
+                return 0;
+            }
+
+            m_Tx->writerWaiting.store(1, std::memory_order_seq_cst);
+            const uint32_t seen = m_Tx->spaceSeq.load(std::memory_order_seq_cst);
+            const bool full = m_Tx->tail.load(std::memory_order_relaxed) - m_Tx->head.load(std::memory_order_seq_cst) == m_Capacity;
+            const bool woke = !full || wait_(m_Tx->spaceSeq, seen, deadline, infinite, cancelGen);
+            m_Tx->writerWaiting.store(0, std::memory_order_relaxed);
+            if (!woke)
+            {
+                return 0;
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t SharedMemoryDriver::bytesAvailable() const
+    {
+        if (!isOpen())
+        {
+            return 0;
+        }
+        return m_Rx->tail.load(std::memory_order_acquire) - m_Rx->head.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t SharedMemoryDriver::bytesPending() const
+    {
+        if (!isOpen())
+        {
+            return 0;
+        }
+        return m_Tx->tail.load(std::memory_order_relaxed) - m_Tx->head.load(std::memory_order_acquire);
+    }
+
+    void SharedMemoryDriver::cancelIo()
+    {
+        if (!isOpen())
+        {
+            return;
+        }
+        m_CancelGen.fetch_add(1, std::memory_order_release);
+        // kick our own waiters; the peer just sees a spurious wake-up
+        m_Rx->dataSeq.fetch_add(1, std::memory_order_seq_cst);
+        wake_(m_Rx->dataSeq);
+        m_Tx->spaceSeq.fetch_add(1, std::memory_order_seq_cst);
+        wake_(m_Tx->spaceSeq);
+    }
+
+    const SharedMemoryDriver::TimeoutPolicy &SharedMemoryDriver::getTimeoutPolicy() const
+    {
+        return m_Policy;
+    }
+
+    const SharedMemoryDriver::SerialSettings &SharedMemoryDriver::getSerialSettings() const
+    {
+        return m_Settings;
+    }
+
+    std::span<const uint8_t> SharedMemoryDriver::readableRegion() const
+    {
+        if (!isOpen())
+        {
+            return {};
+        }
+        const uint32_t head = m_Rx->head.load(std::memory_order_relaxed);
+        const uint32_t avail = m_Rx->tail.load(std::memory_order_acquire) - head;
+        const uint32_t at = head & (m_Capacity - 1);
+        return {m_RxData + at, std::min(avail, m_Capacity - at)};
+    }
+
+    void SharedMemoryDriver::consume(std::size_t n)
+    {
+        const uint32_t head = m_Rx->head.load(std::memory_order_relaxed);
+        const uint32_t avail = m_Rx->tail.load(std::memory_order_acquire) - head;
+        m_Rx->head.store(head + static_cast<uint32_t>(std::min<std::size_t>(n, avail)), std::memory_order_seq_cst);
+        m_Rx->spaceSeq.fetch_add(1, std::memory_order_seq_cst);
+        if (m_Rx->writerWaiting.load(std::memory_order_seq_cst))
+        {
+            wake_(m_Rx->spaceSeq);
+        }
+    }
+
+    bool SharedMemoryDriver::wait_(std::atomic<uint32_t> &word, uint32_t seen, std::chrono::steady_clock::time_point deadline,
+                                   bool infinite, uint32_t cancelGen)
+    {
+        if (m_CancelGen.load(std::memory_order_acquire) != cancelGen)
+        {
+            return false;
+        }
+
+        timespec ts{};
+        timespec* tsp = nullptr;
+        if (!infinite)
+        {
+            const auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::steady_clock::duration::zero())
+            {
+                return false;
+            }
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+            ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+            tsp = &ts;
+        }
+
+        // shared (not FUTEX_PRIVATE) futex: the peer process wakes us
+        (void)::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, seen, tsp, nullptr, 0);
+        return m_CancelGen.load(std::memory_order_acquire) == cancelGen;
+    }
+
+    void SharedMemoryDriver::wake_(std::atomic<uint32_t> &word)
+    {
+        (void)::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    void SharedMemoryDriver::throwErrno_(const char* what)
+    {
+        throw SerialError(std::error_code(errno, std::system_category()), what);
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <memory>
+#include <ComLibPP/TransactionEngine.hpp>
+
+namespace ucpgr
+{
+    // longest single wait in the driver: a backstop for drivers that drop a cancelIo
+    // arriving just before the read it was meant to interrupt
+    static constexpr std::chrono::milliseconds kWaitSlice {100};
+
+    TransactionEngine::TransactionEngine(ISerialDriver &driver, Framer framer, KeyOf keyOf)
+        : TransactionEngine(driver, std::move(framer), std::move(keyOf), Options{})
+    {
+    }
+
+    TransactionEngine::TransactionEngine(ISerialDriver &driver, Framer framer, KeyOf keyOf, const Options &options)
+        : m_Driver(driver), m_Framer(std::move(framer)), m_KeyOf(std::move(keyOf)), m_Options(options)
+    {
+        m_Options.window = std::max<std::size_t>(m_Options.window, 1);
+        m_InFlight.reserve(m_Options.window);
+    }
+
+    TransactionEngine::~TransactionEngine()
+    {
+        cancelAll();
+    }
+
+    std::future<TransactionEngine::Result> TransactionEngine::submit(Key key, std::span<const uint8_t> request)
+    {
+        return submit(key, request, m_Options.limits);
+    }
+
+    std::future<TransactionEngine::Result> TransactionEngine::submit(Key key, std::span<const uint8_t> request,
+                                                                     const Limits &limits)
+    {
+        auto promise = std::make_shared<std::promise<Result>>();
+        auto future = promise->get_future();
+        submit(key, request, limits, [promise](Result &&result) { promise->set_value(std::move(result)); });
+        return future;
+    }
+
+    void TransactionEngine::submit(Key key, std::span<const uint8_t> request, const Limits &limits, Callback onDone)
+    {
+        Transaction txn{key, {request.begin(), request.end()}, limits, std::move(onDone)};
+        txn.submitted = Clock::now();
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Queue.push_back(std::move(txn));
+        }
+
+        // pairs with pump(): either it sees the new count and skips its wait, or we see it waiting
+        m_Submitted.fetch_add(1);
+        if (m_PumpWaiting.load() && m_InFlightCount.load(std::memory_order_relaxed) < m_Options.window)
+        {
+            m_Driver.cancelIo();
+        }
+    }
+
+    std::size_t TransactionEngine::pump(std::chrono::milliseconds timeout)
+    {
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = Clock::now() + std::max(timeout, std::chrono::milliseconds{0});
+
+        std::size_t done = 0;
+        for (;;)
+        {
+            const uint64_t submitted = m_Submitted.load();
+            const auto now = Clock::now();
+            done += expire_(now);
+            launch_(now);
+            if (m_InFlight.empty())
+            {
+                return done;
+            }
+            if (!infinite && now >= deadline)
+            {
+                // a caller polling with 0ms still needs to hear the answers
+                return done + receive_(std::chrono::milliseconds{0});
+            }
+
+            // sleep in the driver until the first transaction expires (or our own deadline)
+            auto wakeAt = std::min_element(m_InFlight.begin(), m_InFlight.end(),
+                                           [](const Transaction &a, const Transaction &b) { return a.deadline < b.deadline; })->deadline;
+            if (!infinite)
+            {
+                wakeAt = std::min(wakeAt, deadline);
+            }
+            const auto wait = std::chrono::ceil<std::chrono::milliseconds>(std::max(wakeAt - now, Clock::duration::zero()));
+
+            m_PumpWaiting.store(true);
+            if (m_Submitted.load() == submitted)
+            {
+                done += receive_(std::min(wait, kWaitSlice));
+            }
+            m_PumpWaiting.store(false);
+        }
+    }
+
+    void TransactionEngine::cancelAll()
+    {
+        std::deque<Transaction> queued;
+        {
+            std::lock_guard lock(m_Mutex);
+            queued.swap(m_Queue);
+        }
+
+        const auto now = Clock::now();
+        for (Transaction &txn : m_InFlight)
+        {
+            complete_(txn, Status::cancelled, {}, now);
+        }
+        m_InFlight.clear();
+        m_InFlightCount.store(0, std::memory_order_relaxed);
+        for (Transaction &txn : queued)
+        {
+            complete_(txn, Status::cancelled, {}, now);
+        }
+    }
+
+    std::size_t TransactionEngine::pending() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_Queue.size() + m_InFlightCount.load(std::memory_order_relaxed);
+    }
+
+    void TransactionEngine::launch_(Clock::time_point now)
+    {
+        while (m_InFlight.size() < m_Options.window)
+        {
+            Transaction txn;
+            {
+                std::lock_guard lock(m_Mutex);
+                // oldest request whose key is not already on the wire
+                const auto next = std::find_if(m_Queue.begin(), m_Queue.end(), [&](const Transaction &queued) {
+                    return std::none_of(m_InFlight.begin(), m_InFlight.end(),
+                                        [&](const Transaction &busy) { return busy.key == queued.key; });
+                });
+                if (next == m_Queue.end())
+                {
+                    break;
+                }
+                txn = std::move(*next);
+                m_Queue.erase(next);
+            }
+
+            send_(txn, now);
+            m_InFlight.push_back(std::move(txn));
+            m_InFlightCount.store(m_InFlight.size(), std::memory_order_relaxed);
+        }
+    }
+
+    bool TransactionEngine::send_(Transaction &txn, Clock::time_point now)
+    {
+        if (txn.attempts++ == 0)
+        {
+            txn.firstSent = now;
+        }
+        txn.deadline = now + txn.limits.timeout;
+
+        // a request goes out whole; a short write just lets this attempt run out
+        std::size_t written = 0;
+        while (written < txn.request.size())
+        {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(txn.deadline - Clock::now());
+            if (left.count() <= 0)
+            {
+                return false;
+            }
+            const std::size_t w = m_Driver.writeSome(txn.request.data() + written, txn.request.size() - written, left);
+            if (w == 0)
+            {
+                return false;
+            }
+            written += w;
+        }
+        return true;
+    }
+
+    std::size_t TransactionEngine::expire_(Clock::time_point now)
+    {
+        std::size_t done = 0;
+        for (std::size_t i = 0; i < m_InFlight.size();)
+        {
+            Transaction &txn = m_InFlight[i];
+            if (txn.deadline > now)
+            {
+                ++i;
+                continue;
+            }
+            if (txn.attempts <= txn.limits.retries)
+            {
+                send_(txn, now);
+                ++i;
+                continue;
+            }
+
+            complete_(txn, Status::timedOut, {}, now);
+            if (&txn != &m_InFlight.back())
+            {
+                txn = std::move(m_InFlight.back());
+            }
+            m_InFlight.pop_back();
+            ++done;
+        }
+        m_InFlightCount.store(m_InFlight.size(), std::memory_order_relaxed);
+        return done;
+    }
+
+    std::size_t TransactionEngine::receive_(std::chrono::milliseconds wait)
+    {
+        const std::size_t kept = m_Rx.size();
+        m_Rx.resize(kept + m_Options.readBytes);
+        const std::size_t got = m_Driver.readSome(m_Rx.data() + kept, m_Options.readBytes, wait);
+        m_Rx.resize(kept + got);
+        if (got == 0)
+        {
+            return 0;
+        }
+
+        const auto now = Clock::now();
+        std::size_t done = 0;
+        std::size_t at = 0;
+        while (at < m_Rx.size())
+        {
+            const std::span<const uint8_t> rest(m_Rx.data() + at, m_Rx.size() - at);
+            const std::size_t length = std::min(m_Framer(rest), rest.size());
+            if (length == 0)
+            {
+                break;
+            }
+            const auto frame = rest.first(length);
+            at += length;
+
+            const auto key = m_KeyOf(frame);
+            const auto owner = !key ? m_InFlight.end() :
+                std::find_if(m_InFlight.begin(), m_InFlight.end(), [&](const Transaction &txn) { return txn.key == *key; });
+            if (owner == m_InFlight.end())
+            {
+                m_Unmatched.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            complete_(*owner, Status::ok, {frame.begin(), frame.end()}, now);
+            if (owner != m_InFlight.end() - 1)
+            {
+                *owner = std::move(m_InFlight.back());
+            }
+            m_InFlight.pop_back();
+            ++done;
+        }
+        m_Rx.erase(m_Rx.begin(), m_Rx.begin() + static_cast<std::ptrdiff_t>(at));
+
+        if (m_Rx.size() > m_Options.maxFrameBytes)
+        {
+            // the framer never found a frame in there: drop it rather than grow forever
+            m_Rx.clear();
+            m_Unmatched.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_InFlightCount.store(m_InFlight.size(), std::memory_order_relaxed);
+        return done;
+    }
+
+    void TransactionEngine::complete_(Transaction &txn, Status status, std::vector<uint8_t> response, Clock::time_point now)
+    {
+        Result result;
+        result.status = status;
+        result.response = std::move(response);
+        result.latency = now - txn.submitted;
+        result.queued = (txn.attempts > 0 ? txn.firstSent : now) - txn.submitted;
+        result.attempts = txn.attempts;
+        if (txn.onDone)
+        {
+            txn.onDone(std::move(result));
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <ComLibPP/TxScheduler.hpp>
+
+namespace ucpgr
+{
+    void TxScheduler::Lane::pop()
+    {
+        const Message &m = front();
+        byteHead = m.begin + m.size;
+        ++msgHead;
+    }
+
+    TxScheduler::TxScheduler(ISerialDriver &driver) : TxScheduler(driver, Options{})
+    {
+    }
+
+    TxScheduler::TxScheduler(ISerialDriver &driver, const Options &options)
+        : m_Driver(driver), m_Options(options)
+    {
+        for (Lane &lane : m_Lanes)
+        {
+            lane.bytes.resize(std::max<std::size_t>(m_Options.queueBytes, 1));
+            lane.messages.resize(std::max<std::size_t>(m_Options.maxMessages, 1));
+        }
+    }
+
+    bool TxScheduler::submit(Priority priority, std::span<const uint8_t> message)
+    {
+        std::lock_guard lock(m_Mutex);
+        Lane &lane = m_Lanes[static_cast<std::size_t>(priority)];
+
+        const std::size_t cap = lane.bytes.size();
+        if (message.empty() ||
+            lane.msgTail - lane.msgHead == lane.messages.size() ||
+            lane.byteTail - lane.byteHead + message.size() > cap)
+        {
+            return false;
+        }
+
+        const auto at = static_cast<std::size_t>(lane.byteTail % cap);
+        const std::size_t first = std::min(message.size(), cap - at);
+        std::memcpy(lane.bytes.data() + at, message.data(), first);
+        std::memcpy(lane.bytes.data(), message.data() + first, message.size() - first);
+
+        lane.messages[lane.msgTail++ % lane.messages.size()] = {lane.byteTail, message.size(), Clock::now()};
+        lane.byteTail += message.size();
+        return true;
+    }
+
+    std::size_t TxScheduler::pump(std::chrono::milliseconds timeout)
+    {
+        const bool infinite = timeout.count() < 0;
+        const auto deadline = Clock::now() + std::max(timeout, std::chrono::milliseconds{0});
+
+        std::size_t total = 0;
+        for (;;)
+        {
+            const uint8_t* src = nullptr;
+            std::size_t chunk = 0;
+            {
+                std::lock_guard lock(m_Mutex);
+                if (!m_Current)
+                {
+                    m_Current = select_(Clock::now());
+                    m_CurrentSent = 0;
+                    if (!m_Current)
+                    {
+                        return total;
+                    }
+                }
+
+                // a message never moves while it is current: its bytes stay reserved until pop
+                const Message &m = m_Current->front();
+                const std::size_t cap = m_Current->bytes.size();
+                const auto at = static_cast<std::size_t>((m.begin + m_CurrentSent) % cap);
+                src = m_Current->bytes.data() + at;
+                chunk = std::min(m.size - m_CurrentSent, cap - at);
+            }
+
+            const std::size_t room = room_();
+            if (room == 0)
+            {
+                const auto now = Clock::now();
+                if (!infinite && now >= deadline)
+                {
+                    return total;
+                }
+                auto wait = std::chrono::duration_cast<Clock::duration>(m_Options.pacing / 2);
+                if (!infinite)
+                {
+                    wait = std::min(wait, deadline - now);
+                }
+                std::this_thread::sleep_for(std::max(wait, Clock::duration{std::chrono::microseconds{50}}));
+                continue;
+            }
+
+            auto tmo = infinite ? timeout : std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            tmo = infinite ? tmo : std::max(tmo, std::chrono::milliseconds{0});
+            const std::size_t w = m_Driver.writeSome(src, std::min(chunk, room), tmo);
+            if (w == 0)
+            {
+                return total;
+            }
+            total += w;
+
+            std::lock_guard lock(m_Mutex);
+            m_CurrentSent += w;
+            if (m_CurrentSent == m_Current->front().size)
+            {
+                m_Current->pop();
+                m_Current = nullptr;
+            }
+        }
+    }
+
+    std::size_t TxScheduler::pendingMessages(Priority priority) const
+    {
+        std::lock_guard lock(m_Mutex);
+        const Lane &lane = m_Lanes[static_cast<std::size_t>(priority)];
+        return lane.msgTail - lane.msgHead;
+    }
+
+    uint64_t TxScheduler::droppedMessages() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_Dropped;
+    }
+
+    TxScheduler::Lane *TxScheduler::select_(Clock::time_point now)
+    {
+        Lane &high = m_Lanes[static_cast<std::size_t>(Priority::high)];
+        if (!high.empty())
+        {
+            return &high;
+        }
+
+        Lane &low = m_Lanes[static_cast<std::size_t>(Priority::low)];
+        if (m_Options.lowMaxAge.count() > 0)
+        {
+            // FIFO: the stale ones are all at the head
+            while (!low.empty() && now - low.front().enqueued > m_Options.lowMaxAge)
+            {
+                low.pop();
+                ++m_Dropped;
+            }
+        }
+        return low.empty() ? nullptr : &low;
+    }
+
+    std::size_t TxScheduler::room_() const
+    {
+        if (m_Options.pacing.count() <= 0)
+        {
+            return static_cast<std::size_t>(-1);
+        }
+
+        const std::size_t cap = m_Driver.getSerialSettings().bytesFor(m_Options.pacing);
+
+        const std::size_t queued = m_Driver.bytesPending();
+        return queued < cap ? cap - queued : 0;
+    }
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ComLibPP/LoopbackDriver.h"
+#include <ComLibPP/BroadcastReader.hpp>
+
+using namespace std::chrono_literals;
+
+static void writeAll(ucpgr::LoopbackDriver &driver, const std::string &text)
+{
+    driver.writeSome(reinterpret_cast<const uint8_t*>(text.data()), text.size(), 0ms);
+}
+
+static std::string toString(const ucpgr::BroadcastReader::Chunk &chunk)
+{
+    return {reinterpret_cast<const char*>(chunk.data().data()), chunk.data().size()};
+}
+
+TEST_CASE("Every subscriber sees the same chunks", "[broadcast]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    ucpgr::BroadcastReader reader{driver, {.slabSize = 8}};
+
+    auto logger  = reader.subscribe();
+    auto decoder = reader.subscribe();
+
+    writeAll(driver, "0123456789abcdef");
+    REQUIRE(reader.pump(0ms) == 8);
+    REQUIRE(reader.pump(0ms) == 8);
+    REQUIRE(reader.pump(0ms) == 0);
+
+    for (auto *sub : {&logger, &decoder})
+    {
+        auto first = sub->poll();
+        auto second = sub->poll();
+        REQUIRE(first);
+        REQUIRE(second);
+        REQUIRE(toString(*first) == "01234567");
+        REQUIRE(toString(*second) == "89abcdef");
+        REQUIRE_FALSE(sub->poll());
+    }
+
+    // both subscribers were handed the same slab, not a copy
+    auto late = reader.subscribe();
+    writeAll(driver, "xyz");
+    reader.pump(0ms);
+    auto a = logger.poll();
+    auto b = late.poll();
+    REQUIRE(a);
+    REQUIRE(b);
+    REQUIRE(a->data().data() == b->data().data());
+}
+
+TEST_CASE("Slow consumers are lagged or dropped", "[broadcast]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+
+    SECTION("lag skips to the oldest retained chunk")
+    {
+        ucpgr::BroadcastReader reader{driver, {.slabSize = 1, .ringSlots = 4}};
+        auto sub = reader.subscribe();
+
+        writeAll(driver, "abcdefgh");
+        while (reader.pump(0ms) != 0) {}
+
+        auto chunk = sub.poll();
+        REQUIRE(chunk);
+        REQUIRE(toString(*chunk) == "e");
+        REQUIRE(sub.lostChunks() == 4);
+        REQUIRE_FALSE(sub.isDropped());
+    }
+
+    SECTION("drop detaches the subscriber")
+    {
+        ucpgr::BroadcastReader reader{driver, {.slabSize = 1, .ringSlots = 4,
+                                               .policy = ucpgr::BroadcastReader::SlowConsumerPolicy::drop}};
+        auto sub = reader.subscribe();
+
+        writeAll(driver, "abcdefgh");
+        while (reader.pump(0ms) != 0) {}
+
+        REQUIRE_FALSE(sub.poll());
+        REQUIRE(sub.isDropped());
+    }
+}
+
+TEST_CASE("Held chunks survive ring wrap-around", "[broadcast]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    ucpgr::BroadcastReader reader{driver, {.slabSize = 1, .ringSlots = 2}};
+    auto sub = reader.subscribe();
+
+    writeAll(driver, "a");
+    reader.pump(0ms);
+    auto held = sub.poll();
+    REQUIRE(held);
+
+    writeAll(driver, "bcdef");
+    while (reader.pump(0ms) != 0) {}
+
+    REQUIRE(toString(*held) == "a");
+}
+
+TEST_CASE("Subscribers on other threads never see a recycled slab", "[broadcast]")
+{
+    constexpr std::size_t kSlab = 4;
+    constexpr uint64_t kChunks = 20000;
+    constexpr int kSubscribers = 4;
+
+    // byte j of chunk s is s*7+j, so a chunk can be checked against its sequence
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    std::vector<uint8_t> wire(kChunks * kSlab);
+    for (std::size_t i = 0; i < wire.size(); ++i)
+        wire[i] = static_cast<uint8_t>((i / kSlab) * 7 + i % kSlab);
+    driver.writeSome(wire.data(), wire.size(), 0ms);
+
+    ucpgr::BroadcastReader reader{driver, {.slabSize = kSlab, .ringSlots = 8}};
+    const auto intact = [](const ucpgr::BroadcastReader::Chunk &chunk) {
+        const auto bytes = chunk.data();
+        if (bytes.size() != kSlab)
+            return false;
+        for (std::size_t j = 0; j < kSlab; ++j)
+            if (bytes[j] != static_cast<uint8_t>(chunk.sequence() * 7 + j))
+                return false;
+        return true;
+    };
+
+    std::atomic<bool> pumping {true};
+    std::atomic<int> corrupt {0};
+    std::atomic<int> unordered {0};
+    std::atomic<uint64_t> accounted {0};
+    std::vector<ucpgr::BroadcastReader::Subscription> subs;
+    for (int i = 0; i < kSubscribers; ++i)
+        subs.push_back(reader.subscribe());
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < kSubscribers; ++i)
+    {
+        consumers.emplace_back([&, i] {
+            auto &sub = subs[i];
+            std::deque<ucpgr::BroadcastReader::Chunk> held;  // pin a few slabs past the ring
+            uint64_t seen = 0;
+            uint64_t expected = 0;
+            for (;;)
+            {
+                const bool last = !pumping.load();
+                while (auto chunk = sub.poll())
+                {
+                    if (!intact(*chunk))
+                        ++corrupt;
+                    if (chunk->sequence() < expected)
+                        ++unordered;
+                    expected = chunk->sequence() + 1;
+                    ++seen;
+                    held.push_back(std::move(*chunk));
+                    if (held.size() > static_cast<std::size_t>(i) * 4)
+                    {
+                        if (!intact(held.front()))
+                            ++corrupt;
+                        held.pop_front();
+                    }
+                }
+                if (last)
+                    break;
+            }
+            for (const auto &chunk : held)
+                if (!intact(chunk))
+                    ++corrupt;
+            accounted += seen + sub.lostChunks();
+        });
+    }
+
+    std::size_t peakSlabs = 0;
+    while (reader.pump(0ms) != 0)
+        peakSlabs = std::max(peakSlabs, reader.slabCount());
+    pumping = false;
+    for (auto &c : consumers)
+        c.join();
+
+    CHECK(reader.published() == kChunks);
+    CHECK(corrupt == 0);
+    CHECK(unordered == 0);
+    CHECK(accounted == kSubscribers * kChunks);
+    CHECK(peakSlabs >= 9);
+}
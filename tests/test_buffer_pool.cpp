@@ -0,0 +1,81 @@
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ComLibPP/LoopbackDriver.h"
+#include <ComLibPP/BufferPool.hpp>
+#include <ComLibPP/ComLibPP.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Buffer pool recycles blocks by size class", "[pool]")
+{
+    ucpgr::BufferPool pool{{.minBlock = 512, .maxBlock = 8192}};
+
+    auto a = pool.borrow(3000);
+    REQUIRE(a.size == 4096);
+    REQUIRE(pool.outstanding() == 1);
+
+    uint8_t* first = a.data;
+    pool.giveBack(a);
+    REQUIRE(pool.outstanding() == 0);
+    REQUIRE(pool.cachedBlocks() == 1);
+
+    auto b = pool.borrow(4096);
+    REQUIRE(b.data == first);
+    pool.giveBack(b);
+
+    auto big = pool.borrow(100000);
+    REQUIRE(big.size == 100000);
+    pool.giveBack(big);
+    REQUIRE(pool.cachedBlocks() == 1);
+
+    pool.trim();
+    REQUIRE(pool.cachedBlocks() == 0);
+}
+
+TEST_CASE("Pooled SerialStream borrows lazily and returns idle buffers", "[pool][serial]")
+{
+    ucpgr::BufferPool pool;
+
+    SECTION("idle ports hold no blocks")
+    {
+        std::vector<std::unique_ptr<ucpgr::SerialStream<ucpgr::LoopbackDriver>>> fleet;
+        for (int i = 0; i < 100; ++i)
+        {
+            auto &s = fleet.emplace_back(std::make_unique<ucpgr::SerialStream<ucpgr::LoopbackDriver>>(std::string{"LOOPBACK"}));
+            s->rdbuf()->usePool(pool, 50ms);
+            REQUIRE_FALSE(s->rdbuf()->holdsBuffers());
+
+            // a poll that times out must not pin a block
+            REQUIRE(s->peek() == std::char_traits<char>::eof());
+            s->clear();
+        }
+        REQUIRE(pool.outstanding() == 0);
+    }
+
+    SECTION("active port round-trips and gives blocks back once idle")
+    {
+        ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{"LOOPBACK"}};
+        stream.rdbuf()->usePool(pool, 0ms);
+
+        const std::string msg(300, 'x');
+        stream << msg << '\n' << std::flush;
+        REQUIRE(pool.outstanding() == 1);
+
+        std::string line;
+        REQUIRE(std::getline(stream, line));
+        REQUIRE(line == msg);
+
+        stream.rdbuf()->releaseIdle();
+        REQUIRE_FALSE(stream.rdbuf()->holdsBuffers());
+        REQUIRE(pool.outstanding() == 0);
+
+        stream << "again\n" << std::flush;
+        REQUIRE(std::getline(stream, line));
+        REQUIRE(line == "again");
+    }
+}
@@ -0,0 +1,187 @@
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ComLibPP/LoopbackDriver.h"
+#include <ComLibPP/FleetIo.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std::chrono_literals;
+using ucpgr::FleetIo;
+
+#ifndef _WIN32
+namespace
+{
+    // loopback through a pipe, so the fleet can poll it
+    class PipeDriver final : public ucpgr::ISerialDriver
+    {
+    public:
+        PipeDriver()
+        {
+            int fds[2];
+            REQUIRE(::pipe(fds) == 0);
+            m_Read = fds[0];
+            m_Write = fds[1];
+            ::fcntl(m_Read, F_SETFL, O_NONBLOCK);
+            ::fcntl(m_Write, F_SETFL, O_NONBLOCK);
+        }
+        ~PipeDriver() override { close(); }
+
+        void open(std::string, const SerialSettings &, const TimeoutPolicy &) override {}
+        void open(std::string, uint32_t) override {}
+        [[nodiscard]] bool isOpen() const override { return m_Read >= 0; }
+        void close() override
+        {
+            if (m_Read >= 0) { ::close(m_Read); m_Read = -1; }
+            hangUp();
+        }
+        // the peer goes away: reads see POLLHUP and return nothing
+        void hangUp()
+        {
+            if (m_Write >= 0) { ::close(m_Write); m_Write = -1; }
+        }
+        void setLineCoding(const SerialSettings &) override {}
+        void setTimeouts(const TimeoutPolicy &) override {}
+        std::size_t readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds) override
+        {
+            ++reads;
+            const auto got = ::read(m_Read, dst, maxBytes);
+            return got > 0 ? static_cast<std::size_t>(got) : 0;
+        }
+        std::size_t writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds) override
+        {
+            const auto w = ::write(m_Write, src, n);
+            return w > 0 ? static_cast<std::size_t>(w) : 0;
+        }
+        [[nodiscard]] std::size_t bytesAvailable() const override { return 0; }
+        void cancelIo() override {}
+        [[nodiscard]] int pollDescriptor() const override { return m_Read; }
+        const TimeoutPolicy& getTimeoutPolicy() const override { return m_Policy; }
+        const SerialSettings& getSerialSettings() const override { return m_Settings; }
+
+        int reads {0};
+
+    private:
+        int m_Read {-1};
+        int m_Write {-1};
+        TimeoutPolicy m_Policy {};
+        SerialSettings m_Settings {};
+    };
+}
+
+TEST_CASE("Fleet polls many descriptor-backed ports in one pass", "[fleet]")
+{
+    constexpr std::size_t kPorts = 50;
+    std::vector<std::unique_ptr<PipeDriver>> ports;
+    std::vector<std::array<uint8_t, 4>> rx(kPorts);
+    std::vector<FleetIo::Operation> ops;
+
+    const auto deadline = FleetIo::Clock::now() + 200ms;
+    for (std::size_t i = 0; i < kPorts; ++i)
+    {
+        auto &port = ports.emplace_back(std::make_unique<PipeDriver>());
+        ops.push_back(FleetIo::Operation::read(*port, rx[i], deadline, rx[i].size()));
+    }
+
+    // only every other port answers
+    const std::array<uint8_t, 4> reply{1, 2, 3, 4};
+    for (std::size_t i = 0; i < kPorts; i += 2)
+        ports[i]->writeSome(reply.data(), reply.size(), 0ms);
+
+    FleetIo fleet;
+    std::size_t completions = 0;
+    const std::size_t done = fleet.run(ops, [&](FleetIo::Operation &) { ++completions; });
+
+    REQUIRE(done == kPorts / 2);
+    REQUIRE(completions == kPorts);
+    for (std::size_t i = 0; i < kPorts; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            REQUIRE(ops[i].status == FleetIo::Status::done);
+            REQUIRE(rx[i] == reply);
+        }
+        else
+        {
+            REQUIRE(ops[i].status == FleetIo::Status::timedOut);
+            // silent ports were never read: readiness said there was nothing
+            REQUIRE(ports[i]->reads == 0);
+        }
+    }
+}
+
+TEST_CASE("Fleet fails a read whose peer hung up instead of spinning", "[fleet]")
+{
+    PipeDriver live;
+    PipeDriver dead;
+    std::array<uint8_t, 4> rxLive{};
+    std::array<uint8_t, 4> rxDead{};
+    const auto deadline = FleetIo::Clock::now() + 2s;
+    std::vector<FleetIo::Operation> ops{
+        FleetIo::Operation::read(live, rxLive, deadline),
+        FleetIo::Operation::read(dead, rxDead, deadline),
+    };
+
+    dead.hangUp();
+    FleetIo fleet;
+    const auto start = FleetIo::Clock::now();
+    REQUIRE(fleet.step(ops, 1s) == 1);
+    CHECK(FleetIo::Clock::now() - start < 500ms);
+    CHECK(ops[1].status == FleetIo::Status::failed);
+    CHECK(ops[1].error == std::errc::connection_reset);
+    CHECK(dead.reads == 1);
+    CHECK(ops[0].status == FleetIo::Status::pending);
+}
+
+TEST_CASE("Fleet sleeps through the last millisecond before a deadline", "[fleet]")
+{
+    PipeDriver quiet;
+    std::array<uint8_t, 4> rx{};
+    std::vector<FleetIo::Operation> ops{FleetIo::Operation::read(quiet, rx, FleetIo::Clock::now() + 500us)};
+
+    FleetIo fleet;
+    int steps = 0;
+    while (ops[0].status == FleetIo::Status::pending && steps < 100)
+    {
+        (void)fleet.step(ops, 1s);
+        ++steps;
+    }
+    CHECK(ops[0].status == FleetIo::Status::timedOut);
+    CHECK(steps <= 3);
+}
+#endif
+
+TEST_CASE("Fleet drives descriptor-less drivers and honours deadlines", "[fleet]")
+{
+    ucpgr::LoopbackDriver a{"LOOPBACK"};
+    ucpgr::LoopbackDriver b{"LOOPBACK"};
+
+    const std::string request = "READ 40001\r\n";
+    std::array<uint8_t, 12> echoA{};
+    std::array<uint8_t, 12> echoB{};
+    const auto now = FleetIo::Clock::now();
+
+    std::vector<FleetIo::Operation> ops{
+        FleetIo::Operation::write(a, {reinterpret_cast<const uint8_t*>(request.data()), request.size()}, now + 100ms),
+        FleetIo::Operation::read(b, echoB, now + 30ms),
+    };
+
+    FleetIo fleet;
+    REQUIRE(fleet.run(ops) == 1);
+    REQUIRE(ops[0].status == FleetIo::Status::done);
+    REQUIRE(ops[0].transferred == request.size());
+    REQUIRE(ops[1].status == FleetIo::Status::timedOut);
+
+    ops = {FleetIo::Operation::read(a, echoA, FleetIo::Clock::now() + 100ms, echoA.size())};
+    REQUIRE(fleet.run(ops) == 1);
+    REQUIRE(std::string(echoA.begin(), echoA.end()) == request);
+}
@@ -90,3 +90,83 @@ TEST_CASE("Multiple writes preserve ordering", "[serial][ordering]")
         REQUIRE(l2 == "part2");
     }
 }
+
+TEST_CASE("Receive timestamps map stream positions to arrival times", "[serial][timestamp]")
+{
+    ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{kPort}};
+    auto *buf = stream.rdbuf();
+    buf->enableRxTimestamps(true);
+
+    stream << "first\n" << std::flush;
+    const auto before = std::chrono::steady_clock::now();
+    std::string line;
+    REQUIRE(std::getline(stream, line));
+    const auto firstStamp = buf->rxTimestampAt(0);
+    REQUIRE(firstStamp);
+    REQUIRE(firstStamp->monotonic >= before);
+    REQUIRE(buf->rxPosition() == 6);
+
+    stream << "second\n" << std::flush;
+    const auto frameStart = buf->rxPosition();
+    REQUIRE(std::getline(stream, line));
+    const auto secondStamp = buf->rxTimestampAt(frameStart + 3);
+    REQUIRE(secondStamp);
+    REQUIRE(secondStamp->monotonic >= firstStamp->monotonic);
+
+    REQUIRE_FALSE(buf->rxTimestampAt(buf->rxPosition()));
+}
+
+TEST_CASE("TX pacing bounds the queue below the stream", "[serial][pacing]")
+{
+    // 1 Mbaud 8N1 -> 100 chars/ms; 1 ms target keeps ~100 bytes in the driver queue
+    ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{kPort}, 1000000u};
+    auto *buf = stream.rdbuf();
+    buf->setTxPacing(1ms);
+
+    const std::string bulk(8000, 'b');
+    stream.write(bulk.data(), static_cast<std::streamsize>(bulk.size()));
+
+    REQUIRE(buf->txBacklog() > 0);
+
+    // urgent data can still replace what has not been handed down yet
+    REQUIRE(buf->discardOutput() > 0);
+    REQUIRE(buf->txBacklog() == 0);
+
+    stream << "alarm\n" << std::flush;
+    REQUIRE(buf->txBacklog() == 0);
+
+    std::string line;
+    REQUIRE(std::getline(stream, line));
+    REQUIRE(line.size() >= 5);
+    REQUIRE(line.substr(line.size() - 5) == "alarm");
+    REQUIRE(line.size() < bulk.size());
+}
+
+TEST_CASE("PutIterator writes straight into the put area", "[serial][format]")
+{
+    ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{kPort}};
+    auto *buf = stream.rdbuf();
+
+    // more than one put area's worth: the iterator flushes as it fills
+    const std::string bulk(10000, 'x');
+    auto out = std::copy(bulk.begin(), bulk.end(), buf->putIterator());
+    *out++ = '\n';
+    REQUIRE_FALSE(out.failed());
+    REQUIRE(buf->txBacklog() < bulk.size());
+
+#if defined(__cpp_lib_format)
+    REQUIRE(buf->print("t={} v={:.2f}\n", 42, 1.5));
+    stream.print("{:>4}|{}\n", "ok", 'c');
+#endif
+    stream.flush();
+
+    std::string line;
+    REQUIRE(std::getline(stream, line));
+    REQUIRE(line == bulk);
+#if defined(__cpp_lib_format)
+    REQUIRE(std::getline(stream, line));
+    REQUIRE(line == "t=42 v=1.50");
+    REQUIRE(std::getline(stream, line));
+    REQUIRE(line == "  ok|c");
+#endif
+}
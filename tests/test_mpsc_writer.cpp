@@ -0,0 +1,223 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ComLibPP/LoopbackDriver.h"
+#include <ComLibPP/MpscWriter.hpp>
+
+using namespace std::chrono_literals;
+using ucpgr::MpscWriter;
+
+static std::span<const uint8_t> bytes(const std::string &s)
+{
+    return {reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+static std::string drain(ucpgr::LoopbackDriver &driver)
+{
+    std::string out(driver.bytesAvailable(), '\0');
+    driver.readSome(reinterpret_cast<uint8_t*>(out.data()), out.size(), 0ms);
+    return out;
+}
+
+namespace
+{
+    // records every writeSome; takes everything
+    class CountingDriver final : public ucpgr::ISerialDriver
+    {
+    public:
+        void open(std::string, const SerialSettings &, const TimeoutPolicy &) override {}
+        void open(std::string, uint32_t) override {}
+        [[nodiscard]] bool isOpen() const override { return true; }
+        void close() override {}
+        void setLineCoding(const SerialSettings &) override {}
+        void setTimeouts(const TimeoutPolicy &) override {}
+        std::size_t readSome(uint8_t*, std::size_t, std::chrono::milliseconds) override { return 0; }
+        std::size_t writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds) override
+        {
+            ++writes;
+            out.append(reinterpret_cast<const char*>(src), n);
+            return n;
+        }
+        [[nodiscard]] std::size_t bytesAvailable() const override { return 0; }
+        void cancelIo() override {}
+        const TimeoutPolicy& getTimeoutPolicy() const override { return m_Policy; }
+        const SerialSettings& getSerialSettings() const override { return m_Settings; }
+
+        int writes {0};
+        std::string out;
+
+    private:
+        TimeoutPolicy m_Policy {};
+        SerialSettings m_Settings {};
+    };
+}
+
+TEST_CASE("MpscWriter keeps messages whole and per-thread ordered", "[mpsc]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    ucpgr::SerialStreamBuf buf{driver};
+    MpscWriter writer{buf, {.ringBytes = 1024}};
+
+    constexpr int kThreads = 8;
+    constexpr int kMessages = 2000;
+    std::atomic<int> refused {0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&writer, &refused, t] {
+            for (int i = 0; i < kMessages; ++i)
+                if (!writer.submit(bytes("T" + std::to_string(t) + ":" + std::to_string(i) + "\n")))
+                    ++refused;
+        });
+    }
+    for (auto &p : producers)
+        p.join();
+    REQUIRE(refused == 0);
+    writer.flush();
+    REQUIRE(writer.pendingBytes() == 0);
+
+    std::istringstream lines(drain(driver));
+    std::map<int, int> next;
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line))
+    {
+        const auto colon = line.find(':');
+        REQUIRE(line[0] == 'T');
+        REQUIRE(colon != std::string::npos);
+        const int thread = std::stoi(line.substr(1, colon - 1));
+        REQUIRE(std::stoi(line.substr(colon + 1)) == next[thread]++);
+        ++count;
+    }
+    CHECK(count == kThreads * kMessages);
+    CHECK(writer.droppedMessages() == 0);
+}
+
+TEST_CASE("MpscWriter full-ring policies", "[mpsc]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    ucpgr::SerialStreamBuf buf{driver};
+    const std::string msg(24, 'm');  // 8 header + 24 -> one 32-byte record
+
+    SECTION("fail fast")
+    {
+        MpscWriter writer{buf, {.ringBytes = 128, .policy = MpscWriter::FullPolicy::failFast, .flushOnSubmit = false}};
+        for (int i = 0; i < 4; ++i)
+            REQUIRE(writer.submit(bytes(msg)));
+        CHECK_FALSE(writer.submit(bytes(msg)));
+        CHECK_FALSE(writer.submit(bytes(std::string(200, 'x'))));  // can never fit
+
+        CHECK(writer.flush() == 4 * msg.size());
+        CHECK(writer.submit(bytes(msg)));
+    }
+
+    SECTION("drop oldest")
+    {
+        MpscWriter writer{buf, {.ringBytes = 128, .policy = MpscWriter::FullPolicy::dropOldest, .flushOnSubmit = false}};
+        for (char c = 'a'; c < 'g'; ++c)
+            REQUIRE(writer.submit(bytes(std::string(24, c))));
+        CHECK(writer.droppedMessages() == 2);
+
+        writer.flush();
+        const std::string out = drain(driver);
+        REQUIRE(out.size() == 4 * 24);
+        CHECK(out.front() == 'c');
+        CHECK(out.back() == 'f');
+    }
+
+    SECTION("block until a flush makes room")
+    {
+        MpscWriter writer{buf, {.ringBytes = 128, .flushOnSubmit = false}};
+        for (int i = 0; i < 4; ++i)
+            REQUIRE(writer.submit(bytes(msg)));
+
+        std::atomic<bool> accepted {false};
+        std::thread late([&] { accepted = writer.submit(bytes(msg)); });
+        std::this_thread::sleep_for(20ms);
+        CHECK(writer.pendingBytes() == 128);
+        CHECK_FALSE(accepted);
+
+        writer.flush();
+        late.join();
+        CHECK(accepted);
+        writer.flush();
+        CHECK(drain(driver).size() == 5 * msg.size());
+    }
+}
+
+TEST_CASE("MpscWriter drops oldest while a flusher drains", "[mpsc]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    ucpgr::SerialStreamBuf buf{driver};
+    MpscWriter writer{buf, {.ringBytes = 256, .policy = MpscWriter::FullPolicy::dropOldest, .flushOnSubmit = false}};
+
+    constexpr int kThreads = 4;
+    constexpr int kMessages = 5000;
+    std::atomic<bool> producing {true};
+    std::atomic<int> refused {0};
+    std::thread flusher([&] {
+        while (producing)
+            writer.flush();
+    });
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&writer, &refused, t] {
+            for (int i = 0; i < kMessages; ++i)
+                if (!writer.submit(bytes("T" + std::to_string(t) + ":" + std::to_string(i) + "\n")))
+                    ++refused;
+        });
+    }
+    for (auto &p : producers)
+        p.join();
+    producing = false;
+    flusher.join();
+    REQUIRE(refused == 0);
+    writer.flush();
+
+    std::istringstream lines(drain(driver));
+    std::map<int, int> last;
+    std::string line;
+    uint64_t count = 0;
+    while (std::getline(lines, line))
+    {
+        const auto colon = line.find(':');
+        REQUIRE(line[0] == 'T');
+        REQUIRE(colon != std::string::npos);
+        const int thread = std::stoi(line.substr(1, colon - 1));
+        const int seq = std::stoi(line.substr(colon + 1));
+        REQUIRE(last.emplace(thread, -1).first->second < seq);
+        last[thread] = seq;
+        ++count;
+    }
+    CHECK(count + writer.droppedMessages() == kThreads * kMessages);
+}
+
+TEST_CASE("MpscWriter hands a full ring to the driver in one write", "[mpsc]")
+{
+    CountingDriver driver;
+    ucpgr::SerialStreamBuf buf{driver};
+    MpscWriter writer{buf, {.ringBytes = 64 * 1024, .flushOnSubmit = false}};
+
+    std::string expected;
+    for (int i = 0; writer.pendingBytes() + 64 <= 64 * 1024; ++i)
+    {
+        const std::string msg = "message " + std::to_string(i) + std::string(40, '.') + "\n";
+        REQUIRE(writer.submit(bytes(msg)));
+        expected += msg;
+    }
+
+    CHECK(writer.flush() == expected.size());
+    CHECK(driver.writes == 1);
+    CHECK(driver.out == expected);
+    CHECK(writer.shortWrites() == 0);
+}
@@ -0,0 +1,150 @@
+#include <catch2/catch_all.hpp>
+
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <ComLibPP/ComLibPP.hpp>
+#include <ComLibPP/PosixSerialDriver.hpp>
+
+using namespace std::chrono_literals;
+using ucpgr::PosixSerial;
+
+namespace
+{
+    // pseudo-terminal: the driver opens the slave, the test plays the device on the master
+    struct Pty
+    {
+        Pty()
+        {
+            master = ::posix_openpt(O_RDWR | O_NOCTTY);
+            REQUIRE(master >= 0);
+            REQUIRE(::grantpt(master) == 0);
+            REQUIRE(::unlockpt(master) == 0);
+            char name[128];
+            REQUIRE(::ptsname_r(master, name, sizeof name) == 0);
+            slave = name;
+        }
+        ~Pty() { ::close(master); }
+
+        std::string readMaster(std::size_t n) const
+        {
+            std::string out(n, '\0');
+            std::size_t got = 0;
+            while (got < n)
+            {
+                const auto r = ::read(master, out.data() + got, n - got);
+                if (r <= 0)
+                    break;
+                got += static_cast<std::size_t>(r);
+            }
+            out.resize(got);
+            return out;
+        }
+
+        int master {-1};
+        std::string slave;
+    };
+}
+
+TEST_CASE("PosixSerial sets arbitrary rates through termios2", "[posix]")
+{
+    Pty pty;
+    PosixSerial port{pty.slave, 3000000u};
+    CHECK(port.actualBaud() == 3000000u);
+    CHECK(port.pollDescriptor() >= 0);
+
+    // an odd rate and a non-default frame
+    port.setLineCoding({.baud = 250000, .dataBits = 7, .parity = PosixSerial::Parity::even, .stopBits = PosixSerial::StopBits::two});
+    CHECK(port.actualBaud() == 250000u);
+    CHECK(port.getSerialSettings().dataBits == 7);
+
+    CHECK_THROWS_AS(port.setLineCoding({.baud = 9600, .dataBits = 9}), ucpgr::ISerialDriver::SerialError);
+    CHECK(port.actualBaud() == 250000u);
+}
+
+TEST_CASE("PosixSerial moves raw bytes and honours timeouts and cancelIo", "[posix]")
+{
+    Pty pty;
+    PosixSerial port{pty.slave, 12000000u};
+
+    // raw mode: no CR/LF translation, no echo
+    const std::string msg = "ab\r\ncd\n";
+    REQUIRE(::write(pty.master, msg.data(), msg.size()) == static_cast<ssize_t>(msg.size()));
+    std::string got(16, '\0');
+    ucpgr::ISerialDriver::RxTimestamp stamp;
+    const auto n = port.readSomeTimestamped(reinterpret_cast<uint8_t*>(got.data()), got.size(), 500ms, stamp);
+    CHECK(got.substr(0, n) == msg);
+    CHECK(stamp.monotonic.time_since_epoch().count() != 0);
+
+    REQUIRE(port.writeSome(reinterpret_cast<const uint8_t*>(msg.data()), msg.size(), 500ms) == msg.size());
+    CHECK(pty.readMaster(msg.size()) == msg);
+
+    uint8_t byte = 0;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(port.readSome(&byte, 1, 30ms) == 0);
+    CHECK(std::chrono::steady_clock::now() - start >= 30ms);
+
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(20ms);
+        port.cancelIo();
+    });
+    CHECK(port.readSome(&byte, 1, std::chrono::milliseconds{-1}) == 0);
+    canceller.join();
+}
+
+TEST_CASE("PosixSerial cancelIo wakes every waiter and does not linger", "[posix]")
+{
+    Pty pty;
+    PosixSerial port{pty.slave, 115200u};
+    uint8_t byte = 0;
+
+    // nobody is waiting: the next operation runs its full timeout
+    port.cancelIo();
+    auto start = std::chrono::steady_clock::now();
+    CHECK(port.readSome(&byte, 1, 30ms) == 0);
+    CHECK(std::chrono::steady_clock::now() - start >= 30ms);
+
+    // two waiters at once (reader and writer in full-duplex use): one cancel ends both
+    std::atomic<int> woken {0};
+    std::thread first([&] { if (port.readSome(&byte, 1, std::chrono::milliseconds{-1}) == 0) ++woken; });
+    std::thread second([&] {
+        uint8_t other = 0;
+        if (port.readSome(&other, 1, 5s) == 0) ++woken;
+    });
+    std::this_thread::sleep_for(50ms);
+    start = std::chrono::steady_clock::now();
+    port.cancelIo();
+    first.join();
+    second.join();
+    CHECK(woken == 2);
+    CHECK(std::chrono::steady_clock::now() - start < 1s);
+
+    start = std::chrono::steady_clock::now();
+    CHECK(port.readSome(&byte, 1, 30ms) == 0);
+    CHECK(std::chrono::steady_clock::now() - start >= 30ms);
+}
+
+TEST_CASE("SerialStream over PosixSerial at multi-Mbaud", "[posix]")
+{
+    Pty pty;
+    ucpgr::SerialStream<PosixSerial> stream{pty.slave, 6000000u};
+
+    // more than the pty buffers: the device side has to drain concurrently
+    const std::string bulk(20000, 'z');
+    std::string received;
+    std::thread device([&] { received = pty.readMaster(bulk.size() + 1); });
+    stream << bulk << '\n' << std::flush;
+    device.join();
+    CHECK(stream.good());
+    CHECK(received == bulk + "\n");
+}
+
+#endif // __linux__
@@ -0,0 +1,310 @@
+#ifndef _WIN32
+
+#include <catch2/catch_all.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ComLibPP/ComLibPP.hpp>
+#include <ComLibPP/Rfc2217Driver.hpp>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Minimal in-process terminal server on 127.0.0.1: echoes data back (re-escaped)
+    // and acknowledges every COM-PORT-OPTION command with the +100 server form.
+    class StandInServer
+    {
+    public:
+        StandInServer()
+        {
+            m_Listen = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            ::bind(m_Listen, reinterpret_cast<sockaddr*>(&addr), sizeof addr);
+            ::listen(m_Listen, 1);
+            socklen_t len = sizeof addr;
+            ::getsockname(m_Listen, reinterpret_cast<sockaddr*>(&addr), &len);
+            m_Port = ntohs(addr.sin_port);
+            m_Thread = std::thread([this] { serve_(); });
+        }
+
+        ~StandInServer()
+        {
+            ::shutdown(m_Listen, SHUT_RDWR);
+            ::close(m_Listen);
+            m_Thread.join();
+        }
+
+        [[nodiscard]] std::string address() const { return "127.0.0.1:" + std::to_string(m_Port); }
+        [[nodiscard]] uint32_t lastBaud() const { return m_Baud.load(); }
+
+    private:
+        void serve_()
+        {
+            const int fd = ::accept(m_Listen, nullptr, nullptr);
+            if (fd < 0)
+                return;
+
+            enum { data, iac, option, sub, subIac } state = data;
+            std::vector<uint8_t> subneg;
+            uint8_t in[4096];
+            for (;;)
+            {
+                const ssize_t got = ::recv(fd, in, sizeof in, 0);
+                if (got <= 0)
+                    break;
+
+                std::vector<uint8_t> out;
+                for (ssize_t i = 0; i < got; ++i)
+                {
+                    const uint8_t c = in[i];
+                    switch (state)
+                    {
+                        case data:
+                            if (c == 0xFF) state = iac;
+                            else out.push_back(c);
+                            break;
+                        case iac:
+                            if (c == 0xFF) { out.push_back(0xFF); out.push_back(0xFF); state = data; }
+                            else if (c == 250) { subneg.clear(); state = sub; }
+                            else if (c >= 251) state = option;
+                            else state = data;
+                            break;
+                        case option:
+                            state = data;
+                            break;
+                        case sub:
+                            if (c == 0xFF) state = subIac;
+                            else subneg.push_back(c);
+                            break;
+                        case subIac:
+                            if (c == 240)
+                            {
+                                if (subneg.size() >= 6 && subneg[1] == 1)
+                                    m_Baud = (uint32_t{subneg[2]} << 24) | (uint32_t{subneg[3]} << 16) | (uint32_t{subneg[4]} << 8) | subneg[5];
+                                out.insert(out.end(), {0xFF, 250, subneg[0], static_cast<uint8_t>(subneg[1] + 100)});
+                                for (std::size_t k = 2; k < subneg.size(); ++k)
+                                {
+                                    out.push_back(subneg[k]);
+                                    if (subneg[k] == 0xFF) out.push_back(0xFF);
+                                }
+                                out.insert(out.end(), {0xFF, 240});
+                                state = data;
+                            }
+                            else
+                            {
+                                if (c == 0xFF) subneg.push_back(0xFF);
+                                state = sub;
+                            }
+                            break;
+                    }
+                }
+                std::size_t sent = 0;
+                while (sent < out.size())
+                {
+                    const ssize_t w = ::send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+                    if (w <= 0)
+                        break;
+                    sent += static_cast<std::size_t>(w);
+                }
+            }
+            ::close(fd);
+        }
+
+        int                   m_Listen {-1};
+        uint16_t              m_Port {0};
+        std::atomic<uint32_t> m_Baud {0};
+        std::thread           m_Thread;
+    };
+}
+
+TEST_CASE("RFC 2217 driver round-trips data containing IAC", "[rfc2217]")
+{
+    StandInServer server;
+    ucpgr::Rfc2217Driver driver{server.address(), {.baud = 0x00FF2580}, {ucpgr::ISerialDriver::TimeoutMode::finite, 500ms, 500ms}};
+
+    std::vector<uint8_t> payload(20000);
+    for (std::size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<uint8_t>(i % 7 == 0 ? 0xFF : i);
+
+    REQUIRE(driver.writeSome(payload.data(), payload.size(), 500ms) == payload.size());
+
+    std::vector<uint8_t> echoed;
+    uint8_t buf[1024];
+    while (echoed.size() < payload.size())
+    {
+        const std::size_t got = driver.readSome(buf, sizeof buf, 500ms);
+        REQUIRE(got > 0);
+        echoed.insert(echoed.end(), buf, buf + got);
+    }
+
+    REQUIRE(echoed == payload);
+    REQUIRE(server.lastBaud() == 0x00FF2580);
+    REQUIRE(driver.getConfirmedSettings().baud == 0x00FF2580);
+}
+
+TEST_CASE("RFC 2217 driver behind SerialStream", "[rfc2217]")
+{
+    StandInServer server;
+    ucpgr::SerialStream<ucpgr::Rfc2217Driver> stream{server.address()};
+
+    stream << "ATI\r\n" << std::flush;
+
+    std::string line;
+    REQUIRE(std::getline(stream, line));
+    REQUIRE(line == "ATI\r");
+}
+
+TEST_CASE("RFC 2217 cancelIo interrupts a blocking read", "[rfc2217]")
+{
+    StandInServer server;
+    ucpgr::Rfc2217Driver driver{server.address(), 9600};
+
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(50ms);
+        driver.cancelIo();
+    });
+
+    uint8_t buf[16];
+    REQUIRE(driver.readSome(buf, sizeof buf, std::chrono::milliseconds{-1}) == 0);
+    canceller.join();
+}
+
+TEST_CASE("RFC 2217 writes keep order under backpressure", "[rfc2217]")
+{
+    StandInServer server;
+    ucpgr::Rfc2217Driver driver{server.address(), 115200};
+
+    // the echo server stops reading while we don't read, so sends go partial
+    std::vector<uint8_t> payload(1 << 20);
+    for (std::size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<uint8_t>(i % 5 == 0 ? 0xFF : i * 31);
+
+    std::vector<uint8_t> echoed;
+    std::vector<uint8_t> buf(8192);
+    std::size_t queued = 0;
+    int idle = 0;
+    while (echoed.size() < payload.size() && idle < 100)
+    {
+        std::size_t w = 0;
+        if (queued < payload.size())
+        {
+            w = driver.writeSome(payload.data() + queued, std::min<std::size_t>(4096, payload.size() - queued), 0ms);
+            queued += w;
+        }
+        const std::size_t got = driver.readSome(buf.data(), buf.size(), w == 0 ? 20ms : 0ms);
+        echoed.insert(echoed.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(got));
+        idle = w == 0 && got == 0 ? idle + 1 : 0;
+    }
+
+    REQUIRE(echoed.size() == payload.size());
+    REQUIRE(echoed == payload);
+    CHECK(driver.bytesPending() == 0);
+}
+
+TEST_CASE("RFC 2217 writeSome reports only what reached the socket", "[rfc2217]")
+{
+    // a peer that does not read: the socket fills and the write timeout runs out
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof addr) == 0);
+    REQUIRE(::listen(listener, 1) == 0);
+    socklen_t len = sizeof addr;
+    ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    std::vector<uint8_t> payload(16 << 20);
+    for (std::size_t i = 0; i < payload.size(); ++i)
+        payload[i] = static_cast<uint8_t>(((i * 2654435761u) >> 13) % 255);  // no 0xFF
+
+    std::size_t written = 0;
+    int peer = -1;
+    {
+        ucpgr::Rfc2217Driver driver{"127.0.0.1:" + std::to_string(ntohs(addr.sin_port)), {},
+                                    {ucpgr::ISerialDriver::TimeoutMode::finite, 100ms, 100ms}};
+        peer = ::accept(listener, nullptr, nullptr);
+        REQUIRE(peer >= 0);
+
+        while (written < payload.size())
+        {
+            const std::size_t w = driver.writeSome(payload.data() + written, payload.size() - written, 100ms);
+            if (w == 0)
+                break;
+            written += w;
+        }
+        REQUIRE(written < payload.size());
+        written += driver.writeSome(payload.data() + written, payload.size() - written, 0ms);
+    }
+
+    // everything reported written arrived, and nothing after it
+    std::vector<uint8_t> received;
+    uint8_t buf[65536];
+    for (ssize_t got; (got = ::recv(peer, buf, sizeof buf, 0)) > 0;)
+        received.insert(received.end(), buf, buf + got);
+    REQUIRE(received.size() >= written);
+    CHECK(std::equal(payload.begin(), payload.begin() + static_cast<std::ptrdiff_t>(written),
+                     received.end() - static_cast<std::ptrdiff_t>(written)));
+
+    ::close(peer);
+    ::close(listener);
+}
+
+TEST_CASE("RFC 2217 cancelIo with nothing blocked is not sticky", "[rfc2217]")
+{
+    StandInServer server;
+    ucpgr::Rfc2217Driver driver{server.address(), 9600};
+
+    driver.cancelIo();
+    uint8_t buf[16];
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(driver.readSome(buf, sizeof buf, 50ms) == 0);
+    CHECK(std::chrono::steady_clock::now() - start >= 50ms);
+}
+
+TEST_CASE("RFC 2217 connect gives up after the write timeout", "[rfc2217]")
+{
+    // a listener whose accept queue is full drops further SYNs, so connect would hang
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof addr) == 0);
+    REQUIRE(::listen(listener, 0) == 0);
+    socklen_t len = sizeof addr;
+    ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    std::vector<int> fillers;
+    for (int i = 0; i < 3; ++i)
+    {
+        fillers.push_back(::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0));
+        ::connect(fillers.back(), reinterpret_cast<sockaddr*>(&addr), sizeof addr);
+    }
+    std::this_thread::sleep_for(50ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    CHECK_THROWS_AS(ucpgr::Rfc2217Driver("127.0.0.1:" + std::to_string(ntohs(addr.sin_port)), {},
+                                         {ucpgr::ISerialDriver::TimeoutMode::finite, 200ms, 100ms}),
+                    ucpgr::ISerialDriver::SerialError);
+    CHECK(std::chrono::steady_clock::now() - start < 1s);
+
+    for (const int fd : fillers)
+        ::close(fd);
+    ::close(listener);
+}
+
+#endif // _WIN32
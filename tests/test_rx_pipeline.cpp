@@ -0,0 +1,176 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <ComLibPP/RxPipeline.hpp>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // thread-safe byte queue with blocking reads, standing in for a port
+    class FeedDriver final : public ucpgr::ISerialDriver
+    {
+    public:
+        void feed(const std::vector<uint8_t> &bytes)
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Queue.insert(m_Queue.end(), bytes.begin(), bytes.end());
+            m_Cv.notify_all();
+        }
+
+        void open(std::string, const SerialSettings &, const TimeoutPolicy &) override {}
+        void open(std::string, uint32_t) override {}
+        [[nodiscard]] bool isOpen() const override { return true; }
+        void close() override {}
+        void setLineCoding(const SerialSettings &) override {}
+        void setTimeouts(const TimeoutPolicy &) override {}
+        std::size_t readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout) override
+        {
+            std::unique_lock lock(m_Mutex);
+            m_Cv.wait_for(lock, timeout, [&] { return !m_Queue.empty() || m_Cancelled; });
+            m_Cancelled = false;
+            // short, uneven reads so frames straddle read boundaries
+            const std::size_t n = std::min({maxBytes, m_Queue.size(), std::size_t{7}});
+            std::copy_n(m_Queue.begin(), n, dst);
+            m_Queue.erase(m_Queue.begin(), m_Queue.begin() + static_cast<std::ptrdiff_t>(n));
+            return n;
+        }
+        std::size_t writeSome(const uint8_t*, std::size_t n, std::chrono::milliseconds) override { return n; }
+        [[nodiscard]] std::size_t bytesAvailable() const override { return 0; }
+        void cancelIo() override
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Cancelled = true;
+            m_Cv.notify_all();
+        }
+        const TimeoutPolicy& getTimeoutPolicy() const override { return m_Policy; }
+        const SerialSettings& getSerialSettings() const override { return m_Settings; }
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable m_Cv;
+        std::deque<uint8_t> m_Queue;
+        bool m_Cancelled {false};
+        TimeoutPolicy m_Policy {};
+        SerialSettings m_Settings {};
+    };
+
+    // frames are [length][sequence][payload...]
+    std::vector<uint8_t> frames(std::size_t count)
+    {
+        std::vector<uint8_t> out;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto length = static_cast<uint8_t>(2 + i % 9);
+            out.push_back(length);
+            out.push_back(static_cast<uint8_t>(i));
+            out.insert(out.end(), length - 2, static_cast<uint8_t>(i * 3));
+        }
+        return out;
+    }
+
+    std::size_t lengthPrefixed(std::span<const uint8_t> bytes)
+    {
+        return bytes[0] <= bytes.size() ? bytes[0] : 0;
+    }
+}
+
+TEST_CASE("RxPipeline returns decoded frames in wire order", "[pipeline]")
+{
+    FeedDriver driver;
+    ucpgr::RxPipeline<int> pipeline(driver, lengthPrefixed, [](std::span<const uint8_t> frame) {
+        // uneven decode cost so workers finish out of order
+        if (frame[1] % 5 == 0)
+            std::this_thread::sleep_for(200us);
+        return static_cast<int>(frame[1]);
+    }, {.workers = 4, .window = 8, .chunkBytes = 16});
+
+    constexpr std::size_t kFrames = 500;
+    driver.feed(frames(kFrames));
+
+    for (std::size_t i = 0; i < kFrames; ++i)
+    {
+        const auto result = pipeline.pop(2000ms);
+        REQUIRE(result);
+        REQUIRE(*result == static_cast<int>(i % 256));
+    }
+    CHECK_FALSE(pipeline.poll());
+
+    const auto metrics = pipeline.metrics();
+    CHECK(metrics.framesSliced == kFrames);
+    CHECK(metrics.resultsDelivered == kFrames);
+    CHECK(metrics.chunksDecoded == metrics.chunksPublished);
+    CHECK(metrics.inFlight == 0);
+}
+
+TEST_CASE("RxPipeline stalls the reader when the consumer falls behind", "[pipeline]")
+{
+    FeedDriver driver;
+    ucpgr::RxPipeline<int> pipeline(driver, lengthPrefixed, [](std::span<const uint8_t> frame) {
+        return static_cast<int>(frame[1]);
+    }, {.workers = 2, .window = 2, .chunkBytes = 1});
+
+    driver.feed(frames(20));
+    std::this_thread::sleep_for(50ms);
+
+    auto metrics = pipeline.metrics();
+    CHECK(metrics.inFlight == 2);
+    CHECK(metrics.chunksPublished == 2);
+    CHECK(metrics.readerStalls == 1);
+
+    for (int i = 0; i < 20; ++i)
+        REQUIRE(pipeline.pop(1000ms) == i);
+    metrics = pipeline.metrics();
+    CHECK(metrics.chunksPublished == 20);
+    CHECK(metrics.readerStalled > 0ns);
+}
+
+TEST_CASE("RxPipeline reports decode errors in order and stops cleanly", "[pipeline]")
+{
+    FeedDriver driver;
+    ucpgr::RxPipeline<int> pipeline(driver, lengthPrefixed, [](std::span<const uint8_t> frame) {
+        if (frame[1] == 3)
+            throw std::runtime_error("bad frame");
+        return static_cast<int>(frame[1]);
+    }, {.workers = 3, .chunkBytes = 1});
+
+    driver.feed(frames(6));
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(pipeline.pop(1000ms) == i);
+    CHECK_THROWS_AS(pipeline.pop(1000ms), std::runtime_error);
+    CHECK(pipeline.pop(1000ms) == 4);
+
+    pipeline.stop();
+    CHECK_FALSE(pipeline.pop(-1ms));
+}
+
+TEST_CASE("RxPipeline keeps decoding the rest of a chunk after a bad frame", "[pipeline]")
+{
+    FeedDriver driver;
+    // every byte is a frame; one read of seven bytes lands in a single chunk
+    ucpgr::RxPipeline<int> pipeline(driver, [](std::span<const uint8_t>) { return std::size_t{1}; },
+                                    [](std::span<const uint8_t> frame) {
+        if (frame[0] == 3)
+            throw std::runtime_error("bad frame");
+        return static_cast<int>(frame[0]);
+    }, {.workers = 2});
+
+    driver.feed({0, 1, 2, 3, 4, 5, 6});
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(pipeline.pop(1000ms) == i);
+    CHECK_THROWS_AS(pipeline.pop(1000ms), std::runtime_error);
+    for (int i = 4; i < 7; ++i)
+        REQUIRE(pipeline.pop(1000ms) == i);
+
+    CHECK(pipeline.metrics().chunksPublished == 1);
+    CHECK_FALSE(pipeline.poll());
+}
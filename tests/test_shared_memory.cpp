@@ -0,0 +1,197 @@
+#include <catch2/catch_all.hpp>
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ComLibPP/SharedMemoryDriver.hpp>
+
+using namespace std::chrono_literals;
+using ucpgr::SharedMemoryDriver;
+
+namespace
+{
+    std::string uniqueName(const char* tag)
+    {
+        return "/comlibpp_test_" + std::string(tag) + "_" + std::to_string(::getpid());
+    }
+}
+
+TEST_CASE("SharedMemoryDriver: both directions, including ring wrap", "[shm]")
+{
+    const auto name = uniqueName("rt");
+    SharedMemoryDriver a(name, SharedMemoryDriver::Endpoint::a, {}, {}, 64);
+    SharedMemoryDriver b(name, SharedMemoryDriver::Endpoint::b);
+
+    std::vector<uint8_t> out(48), in(64);
+    for (int round = 0; round < 5; ++round)
+    {
+        std::iota(out.begin(), out.end(), static_cast<uint8_t>(round * 7));
+        REQUIRE(a.writeSome(out.data(), out.size(), 0ms) == out.size());
+        CHECK(a.bytesPending() == out.size());
+        CHECK(b.bytesAvailable() == out.size());
+
+        REQUIRE(b.readSome(in.data(), in.size(), 0ms) == out.size());
+        CHECK(std::equal(out.begin(), out.end(), in.begin()));
+        CHECK(a.bytesPending() == 0);
+    }
+
+    const uint8_t reply[] = {'o', 'k'};
+    REQUIRE(b.writeSome(reply, sizeof(reply), 0ms) == 2);
+    REQUIRE(a.readSome(in.data(), in.size(), 0ms) == 2);
+    CHECK(in[0] == 'o');
+
+    // full ring: writes are partial, then nothing without a reader
+    std::vector<uint8_t> big(100, 0x55);
+    CHECK(a.writeSome(big.data(), big.size(), 0ms) == 64);
+    CHECK(a.writeSome(big.data(), big.size(), 5ms) == 0);
+}
+
+TEST_CASE("SharedMemoryDriver: blocking read is woken by the peer", "[shm]")
+{
+    const auto name = uniqueName("wake");
+    SharedMemoryDriver a(name, SharedMemoryDriver::Endpoint::a);
+    SharedMemoryDriver b(name, SharedMemoryDriver::Endpoint::b);
+
+    std::thread writer([&] {
+        std::this_thread::sleep_for(20ms);
+        const uint8_t byte = 0x42;
+        a.writeSome(&byte, 1, 0ms);
+    });
+
+    uint8_t got = 0;
+    CHECK(b.readSome(&got, 1, std::chrono::milliseconds{-1}) == 1);
+    CHECK(got == 0x42);
+    writer.join();
+}
+
+TEST_CASE("SharedMemoryDriver: timeout and cancelIo end a wait", "[shm]")
+{
+    const auto name = uniqueName("cancel");
+    SharedMemoryDriver a(name, SharedMemoryDriver::Endpoint::a);
+    SharedMemoryDriver b(name, SharedMemoryDriver::Endpoint::b);
+
+    uint8_t byte = 0;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(b.readSome(&byte, 1, 20ms) == 0);
+    CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(20ms);
+        b.cancelIo();
+    });
+    CHECK(b.readSome(&byte, 1, std::chrono::milliseconds{-1}) == 0);
+    canceller.join();
+}
+
+TEST_CASE("SharedMemoryDriver: zero-copy receive and memfd hand-off", "[shm]")
+{
+    SharedMemoryDriver a("memfd:sim", SharedMemoryDriver::Endpoint::a, {}, {}, 64);
+    SharedMemoryDriver b("fd:" + std::to_string(a.descriptor()), SharedMemoryDriver::Endpoint::b);
+
+    std::vector<uint8_t> filler(60, 1);
+    a.writeSome(filler.data(), filler.size(), 0ms);
+    b.consume(60);
+
+    // 10 bytes starting 4 before the end of the ring: the region stops at the wrap
+    const uint8_t msg[] = "0123456789";
+    REQUIRE(a.writeSome(msg, 10, 0ms) == 10);
+    auto region = b.readableRegion();
+    REQUIRE(region.size() == 4);
+    CHECK(region[0] == '0');
+    b.consume(region.size());
+
+    region = b.readableRegion();
+    REQUIRE(region.size() == 6);
+    CHECK(region[5] == '9');
+    b.consume(region.size());
+    CHECK(b.bytesAvailable() == 0);
+
+    for (const char* bad : {"fd:", "fd:3x", "fd:-1", "fd:99999999999"})
+        CHECK_THROWS_AS(SharedMemoryDriver(bad, SharedMemoryDriver::Endpoint::b), ucpgr::ISerialDriver::SerialError);
+}
+
+TEST_CASE("SharedMemoryDriver: attach rejects a bad ring capacity", "[shm]")
+{
+    SharedMemoryDriver a("memfd:bad", SharedMemoryDriver::Endpoint::a, {}, {}, 64);
+
+    // the header starts with uint32 magic, uint32 capacity
+    auto *map = static_cast<uint8_t*>(::mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, a.descriptor(), 0));
+    REQUIRE(map != MAP_FAILED);
+    for (const uint32_t capacity : {0u, 48u, 1u << 20})
+    {
+        std::memcpy(map + 4, &capacity, sizeof capacity);
+        CHECK_THROWS_AS(SharedMemoryDriver("fd:" + std::to_string(a.descriptor()), SharedMemoryDriver::Endpoint::b),
+                        ucpgr::ISerialDriver::SerialError);
+    }
+    ::munmap(map, 64);
+}
+
+TEST_CASE("SharedMemoryDriver: echo across two processes", "[shm]")
+{
+    SharedMemoryDriver a("memfd:fork", SharedMemoryDriver::Endpoint::a, {}, {}, 4096);
+
+    const pid_t child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0)
+    {
+        // peer: echo every byte back incremented until the parent goes quiet
+        int status = 1;
+        try
+        {
+            SharedMemoryDriver b("fd:" + std::to_string(a.descriptor()), SharedMemoryDriver::Endpoint::b);
+            uint8_t buf[1024];
+            for (std::size_t got; (got = b.readSome(buf, sizeof buf, 500ms)) > 0;)
+            {
+                for (std::size_t i = 0; i < got; ++i)
+                    ++buf[i];
+                for (std::size_t sent = 0; sent < got;)
+                    sent += b.writeSome(buf + sent, got - sent, std::chrono::milliseconds{-1});
+            }
+            status = 0;
+        }
+        catch (...)
+        {
+        }
+        ::_exit(status);
+    }
+
+    std::vector<uint8_t> out(1 << 20);
+    for (std::size_t i = 0; i < out.size(); ++i)
+        out[i] = static_cast<uint8_t>(i * 13);
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> buf(4096);
+    std::size_t sent = 0;
+    int idle = 0;
+    while (in.size() < out.size() && idle < 100)
+    {
+        std::size_t w = 0;
+        if (sent < out.size())
+        {
+            w = a.writeSome(out.data() + sent, std::min<std::size_t>(1024, out.size() - sent), 0ms);
+            sent += w;
+        }
+        const std::size_t got = a.readSome(buf.data(), buf.size(), w == 0 ? 20ms : 0ms);
+        in.insert(in.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(got));
+        idle = w == 0 && got == 0 ? idle + 1 : 0;
+    }
+
+    int status = -1;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    CHECK(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+    REQUIRE(in.size() == out.size());
+    CHECK(std::equal(out.begin(), out.end(), in.begin(), [](uint8_t o, uint8_t i) { return i == static_cast<uint8_t>(o + 1); }));
+}
+
+#endif // __linux__
@@ -0,0 +1,257 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <ComLibPP/TransactionEngine.hpp>
+
+using namespace std::chrono_literals;
+using ucpgr::TransactionEngine;
+
+namespace
+{
+    // Device that takes 2-byte requests [tag][value] and answers [tag][value + 1] after
+    // `latency`, any number at a time. Tags in `drop` lose their first request, tags in
+    // `silent` are never answered. cancelIo may come from any thread and wakes readSome.
+    class DeviceDriver final : public ucpgr::ISerialDriver
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit DeviceDriver(std::chrono::milliseconds latency) : m_Latency(latency) {}
+
+        void open(std::string, const SerialSettings &, const TimeoutPolicy &) override {}
+        void open(std::string, uint32_t) override {}
+        [[nodiscard]] bool isOpen() const override { return true; }
+        void close() override {}
+        void setLineCoding(const SerialSettings &) override {}
+        void setTimeouts(const TimeoutPolicy &) override {}
+        std::size_t readSome(uint8_t* dst, std::size_t maxBytes, std::chrono::milliseconds timeout) override
+        {
+            const auto until = Clock::now() + timeout;
+            if (m_Replies.empty() || m_Replies.front().first > until)
+            {
+                sleepUntil_(until);
+                return 0;
+            }
+            if (!sleepUntil_(m_Replies.front().first))
+            {
+                return 0;
+            }
+
+            std::size_t n = 0;
+            while (!m_Replies.empty() && m_Replies.front().first <= Clock::now() && n + 2 <= maxBytes)
+            {
+                dst[n++] = m_Replies.front().second[0];
+                dst[n++] = m_Replies.front().second[1];
+                m_Replies.pop_front();
+                --outstanding;
+            }
+            return n;
+        }
+        std::size_t writeSome(const uint8_t* src, std::size_t n, std::chrono::milliseconds) override
+        {
+            REQUIRE(n == 2);
+            if (silent.count(src[0]) == 0 && drop.erase(src[0]) == 0)
+            {
+                m_Replies.push_back({Clock::now() + m_Latency, {src[0], static_cast<uint8_t>(src[1] + 1)}});
+                peakOutstanding = std::max(peakOutstanding, ++outstanding);
+            }
+            return n;
+        }
+        [[nodiscard]] std::size_t bytesAvailable() const override { return 0; }
+        void cancelIo() override
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Cancelled = true;
+            m_Wake.notify_all();
+        }
+        const TimeoutPolicy& getTimeoutPolicy() const override { return m_Policy; }
+        const SerialSettings& getSerialSettings() const override { return m_Settings; }
+
+        // inject a frame nobody asked for
+        void unsolicited(uint8_t tag) { m_Replies.push_front({Clock::now(), {tag, 0}}); ++outstanding; }
+
+        std::set<uint8_t> drop;
+        std::set<uint8_t> silent;
+        std::size_t outstanding {0};
+        std::size_t peakOutstanding {0};
+
+    private:
+        // false if cancelIo cut the sleep short
+        bool sleepUntil_(Clock::time_point until)
+        {
+            std::unique_lock lock(m_Mutex);
+            const bool cancelled = m_Wake.wait_until(lock, until, [this] { return m_Cancelled; });
+            m_Cancelled = false;
+            return !cancelled;
+        }
+
+        std::chrono::milliseconds m_Latency;
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        bool m_Cancelled {false};
+        std::deque<std::pair<Clock::time_point, std::array<uint8_t, 2>>> m_Replies;
+        TimeoutPolicy m_Policy {};
+        SerialSettings m_Settings {};
+    };
+
+    std::size_t twoBytes(std::span<const uint8_t> bytes)
+    {
+        return bytes.size() >= 2 ? 2 : 0;
+    }
+
+    std::optional<TransactionEngine::Key> tagOf(std::span<const uint8_t> frame)
+    {
+        return frame[0];
+    }
+}
+
+TEST_CASE("TransactionEngine keeps a window of requests on the wire", "[transactions]")
+{
+    DeviceDriver device{20ms};
+    TransactionEngine engine{device, twoBytes, tagOf, {.window = 8}};
+
+    std::vector<std::future<TransactionEngine::Result>> futures;
+    for (uint8_t tag = 0; tag < 24; ++tag)
+    {
+        const uint8_t request[] = {tag, static_cast<uint8_t>(tag * 2)};
+        futures.push_back(engine.submit(tag, request));
+    }
+    REQUIRE(engine.pending() == 24);
+
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(engine.pump(2000ms) == 24);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // three round trips, not twenty-four
+    CHECK(device.peakOutstanding == 8);
+    CHECK(elapsed < 24 * 20ms / 2);
+    CHECK(engine.pending() == 0);
+
+    for (uint8_t tag = 0; tag < 24; ++tag)
+    {
+        auto result = futures[tag].get();
+        REQUIRE(result.status == TransactionEngine::Status::ok);
+        REQUIRE(result.response == std::vector<uint8_t>{tag, static_cast<uint8_t>(tag * 2 + 1)});
+        CHECK(result.attempts == 1);
+        CHECK(result.latency >= 20ms);
+    }
+}
+
+TEST_CASE("TransactionEngine retries, times out and skips unsolicited frames", "[transactions]")
+{
+    DeviceDriver device{5ms};
+    TransactionEngine engine{device, twoBytes, tagOf};
+    device.drop = {1};
+    device.silent = {2};
+
+    const TransactionEngine::Limits limits{.timeout = 30ms, .retries = 2};
+    std::vector<TransactionEngine::Result> results(3);
+    for (uint8_t tag = 0; tag < 3; ++tag)
+    {
+        const uint8_t request[] = {tag, 10};
+        engine.submit(tag, request, limits, [&results, tag](TransactionEngine::Result &&r) { results[tag] = std::move(r); });
+    }
+    device.unsolicited(9);
+
+    REQUIRE(engine.pump(500ms) == 3);
+
+    CHECK(results[0].status == TransactionEngine::Status::ok);
+    CHECK(results[0].attempts == 1);
+    CHECK(results[1].status == TransactionEngine::Status::ok);
+    CHECK(results[1].attempts == 2);
+    CHECK(results[1].latency >= 30ms);
+    CHECK(results[2].status == TransactionEngine::Status::timedOut);
+    CHECK(results[2].attempts == 3);
+    CHECK(engine.unmatchedFrames() == 1);
+}
+
+TEST_CASE("TransactionEngine serialises requests that share a key", "[transactions]")
+{
+    DeviceDriver device{5ms};
+    TransactionEngine engine{device, twoBytes, tagOf};
+
+    const uint8_t first[] = {7, 1};
+    const uint8_t second[] = {7, 2};
+    auto a = engine.submit(7, first);
+    auto b = engine.submit(7, second);
+    engine.pump(500ms);
+
+    CHECK(device.peakOutstanding == 1);
+    CHECK(a.get().response[1] == 2);
+    CHECK(b.get().response[1] == 3);
+
+    const uint8_t never[] = {8, 0};
+    auto c = engine.submit(8, never);
+    engine.cancelAll();
+    CHECK(c.get().status == TransactionEngine::Status::cancelled);
+}
+
+TEST_CASE("TransactionEngine completes when only polled with pump(0ms)", "[transactions]")
+{
+    DeviceDriver device{5ms};
+    TransactionEngine engine{device, twoBytes, tagOf};
+
+    std::vector<std::future<TransactionEngine::Result>> futures;
+    for (uint8_t tag = 0; tag < 3; ++tag)
+    {
+        const uint8_t request[] = {tag, 0};
+        futures.push_back(engine.submit(tag, request, {.timeout = 200ms, .retries = 2}));
+    }
+
+    const auto giveUp = std::chrono::steady_clock::now() + 1s;
+    while (engine.pending() > 0 && std::chrono::steady_clock::now() < giveUp)
+    {
+        engine.pump(0ms);
+        std::this_thread::sleep_for(1ms);
+    }
+
+    for (auto &future : futures)
+    {
+        const auto result = future.get();
+        CHECK(result.status == TransactionEngine::Status::ok);
+        CHECK(result.attempts == 1);
+    }
+}
+
+TEST_CASE("TransactionEngine wakes a blocked pump for a new request", "[transactions]")
+{
+    DeviceDriver device{5ms};
+    device.silent = {1};
+    TransactionEngine engine{device, twoBytes, tagOf};
+
+    const uint8_t slow[] = {1, 0};
+    auto a = engine.submit(1, slow, {.timeout = 1000ms, .retries = 0});
+
+    std::promise<TransactionEngine::Result> fast;
+    auto b = fast.get_future();
+    std::thread submitter([&] {
+        std::this_thread::sleep_for(50ms);
+        const uint8_t request[] = {2, 0};
+        engine.submit(2, request, {.timeout = 1000ms, .retries = 0},
+                      [&fast](TransactionEngine::Result &&r) { fast.set_value(std::move(r)); });
+    });
+    std::thread pumper([&] { engine.pump(2000ms); });
+
+    // the pump is asleep on the silent request; the new one must not wait for it
+    REQUIRE(b.wait_for(500ms) == std::future_status::ready);
+    const auto result = b.get();
+    CHECK(result.status == TransactionEngine::Status::ok);
+    CHECK(result.latency >= 5ms);
+    CHECK(result.latency < 50ms);
+    CHECK(result.queued < result.latency);
+
+    submitter.join();
+    pumper.join();
+    CHECK(a.get().status == TransactionEngine::Status::timedOut);
+}
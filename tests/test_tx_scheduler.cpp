@@ -0,0 +1,83 @@
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ComLibPP/LoopbackDriver.h"
+#include <ComLibPP/TxScheduler.hpp>
+
+using namespace std::chrono_literals;
+using ucpgr::TxScheduler;
+
+static std::span<const uint8_t> bytes(const std::string &s)
+{
+    return {reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+static std::string drain(ucpgr::LoopbackDriver &driver)
+{
+    std::string out(driver.bytesAvailable(), '\0');
+    driver.readSome(reinterpret_cast<uint8_t*>(out.data()), out.size(), 0ms);
+    return out;
+}
+
+TEST_CASE("High priority overtakes queued bulk at a message boundary", "[scheduler]")
+{
+    // 1 Mbaud 8N1, 1 ms of pacing -> about 100 bytes allowed below the scheduler
+    ucpgr::LoopbackDriver driver{"LOOPBACK", 1000000u};
+    TxScheduler scheduler{driver, {.pacing = 1000us}};
+
+    const std::string bulk(50, 'b');
+    for (int i = 0; i < 20; ++i)
+        REQUIRE(scheduler.submit(TxScheduler::Priority::low, bytes(bulk)));
+
+    scheduler.pump(0ms);
+    REQUIRE(scheduler.submit(TxScheduler::Priority::high, bytes("ALARM")));
+    while (scheduler.pendingMessages(TxScheduler::Priority::low) > 0)
+        scheduler.pump(100ms);
+
+    const std::string wire = drain(driver);
+    REQUIRE(wire.size() == 20 * bulk.size() + 5);
+
+    const auto alarm = wire.find("ALARM");
+    REQUIRE(alarm != std::string::npos);
+    REQUIRE(alarm % bulk.size() == 0);       // never splits a bulk message
+    REQUIRE(alarm <= 4 * bulk.size());       // not behind the whole backlog
+}
+
+TEST_CASE("Stale low priority messages age out", "[scheduler]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    TxScheduler scheduler{driver, {.lowMaxAge = 10ms}};
+
+    REQUIRE(scheduler.submit(TxScheduler::Priority::low, bytes("old log line")));
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(scheduler.submit(TxScheduler::Priority::low, bytes("fresh")));
+
+    scheduler.pump(100ms);
+    REQUIRE(scheduler.droppedMessages() == 1);
+    REQUIRE(drain(driver) == "fresh");
+}
+
+TEST_CASE("Full queues reject whole messages", "[scheduler]")
+{
+    ucpgr::LoopbackDriver driver{"LOOPBACK"};
+    TxScheduler scheduler{driver, {.queueBytes = 16, .maxMessages = 2}};
+
+    REQUIRE(scheduler.submit(TxScheduler::Priority::low, bytes("0123456789")));
+    REQUIRE_FALSE(scheduler.submit(TxScheduler::Priority::low, bytes("0123456789")));
+    REQUIRE(scheduler.submit(TxScheduler::Priority::low, bytes("012345")));
+    REQUIRE_FALSE(scheduler.submit(TxScheduler::Priority::low, bytes("x")));
+
+    scheduler.pump(100ms);
+    REQUIRE(drain(driver) == "0123456789012345");
+
+    // wrapped storage is sent in order
+    REQUIRE(scheduler.submit(TxScheduler::Priority::low, bytes("abcdefghijkl")));
+    scheduler.pump(100ms);
+    REQUIRE(drain(driver) == "abcdefghijkl");
+}
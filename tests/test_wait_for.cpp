@@ -0,0 +1,94 @@
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include "ComLibPP/LoopbackDriver.h"
+#include <ComLibPP/ComLibPP.hpp>
+#include <ComLibPP/PatternMatcher.hpp>
+
+using namespace std::chrono_literals;
+
+static constexpr std::array<std::string_view, 3> kModem{"OK\r\n", "ERROR", "CONNECT"};
+
+TEST_CASE("Pattern matcher finds overlapping patterns without backtracking", "[waitfor]")
+{
+    const std::array<std::string_view, 3> patterns{"she", "he", "hers"};
+    const ucpgr::PatternMatcher matcher{patterns};
+
+    auto state = ucpgr::PatternMatcher::kStart;
+    std::string hits;
+    for (const char c : std::string_view{"ushers"})
+    {
+        state = matcher.step(state, static_cast<uint8_t>(c));
+        if (const int p = matcher.match(state); p >= 0)
+            hits += std::to_string(p);
+    }
+    // "she" and "he" end on the same byte: the lower index wins, then "hers"
+    REQUIRE(hits == "02");
+}
+
+TEST_CASE("waitFor returns the matching pattern and what came before it", "[waitfor][serial]")
+{
+    ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{"LOOPBACK"}};
+    auto *buf = stream.rdbuf();
+
+    stream << "ATD123\r\r\nCONNECT 9600\r\n" << std::flush;
+
+    const auto result = buf->waitFor(kModem, std::chrono::steady_clock::now() + 100ms);
+    REQUIRE(result.pattern == 2);
+    REQUIRE(result.before == "ATD123\r\r\n");
+
+    std::string rest;
+    REQUIRE(std::getline(stream, rest));
+    REQUIRE(rest == " 9600\r");
+}
+
+TEST_CASE("waitFor keeps matching across refills", "[waitfor][serial]")
+{
+    ucpgr::BufferPool pool;
+    ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{"LOOPBACK"}};
+    auto *buf = stream.rdbuf();
+    buf->usePool(pool); // an idle pooled port first reads into its 64-byte probe
+
+    const std::string noise(62, '.');
+    stream << noise << "ERROR\r\n" << std::flush;
+
+    const auto result = buf->waitFor(kModem, std::chrono::steady_clock::now() + 100ms);
+    REQUIRE(result.pattern == 1);
+    REQUIRE(result.before == noise);
+}
+
+TEST_CASE("waitFor gives up at the deadline", "[waitfor][serial]")
+{
+    ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{"LOOPBACK"}};
+    auto *buf = stream.rdbuf();
+
+    stream << "NO CARRIER" << std::flush;
+    const auto result = buf->waitFor(kModem, std::chrono::steady_clock::now() + 20ms);
+    REQUIRE(result.pattern == -1);
+    // "ER" could still become "ERROR", so it is not consumed
+    REQUIRE(result.before == "NO CARRI");
+
+    std::string rest;
+    stream >> rest;
+    REQUIRE(rest == "ER");
+}
+
+TEST_CASE("waitFor finds a pattern split across its deadline on retry", "[waitfor][serial]")
+{
+    ucpgr::SerialStream<ucpgr::LoopbackDriver> stream{std::string{"LOOPBACK"}};
+    auto *buf = stream.rdbuf();
+
+    stream << "+CSQ: 12,0\r\nOK\r" << std::flush;
+    const auto first = buf->waitFor(kModem, std::chrono::steady_clock::now() + 20ms);
+    REQUIRE(first.pattern == -1);
+    REQUIRE(first.before == "+CSQ: 12,0\r\n");
+
+    stream << "\n" << std::flush;
+    const auto second = buf->waitFor(kModem, std::chrono::steady_clock::now() + 20ms);
+    REQUIRE(second.pattern == 0);
+    REQUIRE(second.before.empty());
+}